@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "TBench.h"
+
+using namespace std;
+
+void TBenchRunner::add(const string& name, size_t size, function<void(TBenchState&)> fn)
+{
+    entries.push_back({name + "/" + to_string(size), size, std::move(fn)});
+}
+
+int TBenchRunner::run(int argc, char** argv)
+{
+    string filter;
+    size_t maxSize = 10000000;
+    double minTime = 0.1;
+    bool useCounters = true;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strncmp(argv[i], "--filter=", 9))
+            filter = argv[i] + 9;
+        else if (!strncmp(argv[i], "--max-size=", 11))
+            maxSize = strtoull(argv[i] + 11, nullptr, 10);
+        else if (!strncmp(argv[i], "--min-time=", 11))
+            minTime = atof(argv[i] + 11);
+        else if (!strcmp(argv[i], "--no-counters"))
+            useCounters = false;
+        else
+        {
+            fprintf(stderr, "usage: %s [--filter=substr] [--max-size=N] [--min-time=sec] [--no-counters]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    TPerfCounters perf;
+    TPerfCounters* counters = useCounters && perf.available() ? &perf : nullptr;
+    if (useCounters && !counters)
+        fprintf(stderr, "perf_event counters are unavailable (check kernel.perf_event_paranoid)\n");
+
+    printf("%-52s %14s %10s %10s", "Benchmark", "Time/iter", "Iterations", "ns/elem");
+    if (counters)
+        for (int ev = 0; ev < TPerfCounters::EventCount; ev++)
+            printf(" %9s", TPerfCounters::name(TPerfCounters::TEvent(ev)));
+    printf("\n");
+    for (TEntry& e : entries)
+    {
+        if (e.size > maxSize || e.name.find(filter) == string::npos)
+            continue;
+        TBenchState st(e.size, counters);
+        size_t iters = 0;
+        while (st.elapsed() < minTime * 1e9 && iters < 1000000)
+        {
+            e.fn(st);
+            iters++;
+        }
+        double perIter = st.elapsed() / iters;
+        double elems = double(iters) * e.size;
+        printf("%-52s %11.0f ns %10zu %10.2f", e.name.c_str(), perIter, iters, perIter / e.size);
+        if (counters)
+        {
+            // значения счётчиков на один элемент
+            for (int ev = 0; ev < TPerfCounters::EventCount; ev++)
+            {
+                if (counters->has(TPerfCounters::TEvent(ev)))
+                    printf(" %9.2f", st.count(TPerfCounters::TEvent(ev)) / elems);
+                else
+                    printf(" %9s", "-");
+            }
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "TPerfCounters.h"
+
+// Минимальный каркас микробенчмарков в духе Google Benchmark.
+// Функция бенчмарка сама готовит данные и отмечает замеряемый участок
+// вызовами start()/stop(); каркас повторяет её, пока суммарное
+// замеренное время не превысит заданный порог. На том же участке
+// снимаются аппаратные счётчики, если они доступны.
+class TBenchState
+{
+    size_t n;
+    TPerfCounters* perf;
+    std::chrono::steady_clock::time_point t0;
+    double ns = 0;
+    uint64_t events[TPerfCounters::EventCount] = {};
+
+public:
+    TBenchState(size_t size, TPerfCounters* counters) : n(size), perf(counters)
+    {
+    }
+
+    size_t size() const { return n; }
+    double elapsed() const { return ns; }
+    uint64_t count(TPerfCounters::TEvent e) const { return events[e]; }
+
+    void start()
+    {
+        if (perf)
+            perf->start();
+        t0 = std::chrono::steady_clock::now();
+    }
+
+    void stop()
+    {
+        auto t1 = std::chrono::steady_clock::now();
+        if (perf)
+            perf->stop(events);
+        ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+    }
+};
+
+// Не даёт компилятору выбросить вычисление значения v
+template <class T>
+inline void doNotOptimize(const T& v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(v) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &v;
+#endif
+}
+
+class TBenchRunner
+{
+    struct TEntry
+    {
+        std::string name;
+        size_t size;
+        std::function<void(TBenchState&)> fn;
+    };
+
+    std::vector<TEntry> entries;
+
+public:
+    void add(const std::string& name, size_t size, std::function<void(TBenchState&)> fn);
+
+    // Ключи: --filter=подстрока, --max-size=N, --min-time=секунды,
+    // --no-counters (не открывать perf_event)
+    int run(int argc, char** argv);
+};
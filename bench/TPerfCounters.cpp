@@ -0,0 +1,101 @@
+#include "TPerfCounters.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+#ifdef __linux__
+int openEvent(uint32_t type, uint64_t config, int group)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+uint64_t cacheMiss(uint64_t cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+#endif
+
+}
+
+TPerfCounters::TPerfCounters()
+{
+    for (int e = 0; e < EventCount; e++)
+    {
+        fds[e] = -1;
+        ids[e] = ~uint64_t(0);
+    }
+#ifdef __linux__
+    fds[Cycles] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (fds[Cycles] < 0)
+        return;
+    int g = fds[Cycles];
+    fds[Instructions] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, g);
+    fds[L1DMisses] = openEvent(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D), g);
+    fds[LLCMisses] = openEvent(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL), g);
+    fds[BranchMisses] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, g);
+    for (int e = 0; e < EventCount; e++)
+        if (fds[e] >= 0 && ioctl(fds[e], PERF_EVENT_IOC_ID, &ids[e]) < 0)
+            ids[e] = ~uint64_t(0);
+#endif
+}
+
+TPerfCounters::~TPerfCounters()
+{
+#ifdef __linux__
+    for (int fd : fds)
+        if (fd >= 0)
+            close(fd);
+#endif
+}
+
+void TPerfCounters::start()
+{
+#ifdef __linux__
+    if (!available())
+        return;
+    ioctl(fds[Cycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds[Cycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void TPerfCounters::stop(uint64_t acc[EventCount])
+{
+#ifdef __linux__
+    if (!available())
+        return;
+    ioctl(fds[Cycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    // формат группы: nr, затем пары (value, id)
+    uint64_t buf[1 + 2 * EventCount];
+    if (read(fds[Cycles], buf, sizeof(buf)) <= 0)
+        return;
+    for (uint64_t i = 0; i < buf[0]; i++)
+        for (int e = 0; e < EventCount; e++)
+            if (buf[2 + 2 * i] == ids[e])
+                acc[e] += buf[1 + 2 * i];
+#else
+    (void)acc;
+#endif
+}
+
+const char* TPerfCounters::name(TEvent e)
+{
+    static const char* names[EventCount] = {"cyc", "ins", "L1Dmiss", "LLCmiss", "brmiss"};
+    return names[e];
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+
+// Аппаратные счётчики производительности (Linux perf_event) вокруг
+// замеряемого участка бенчмарка. Все счётчики открываются одной группой
+// только для текущего потока и пользовательского режима. Если ядро или
+// окружение не даёт к ним доступа, available() возвращает false, а
+// отдельные неподдерживаемые события помечаются как отсутствующие.
+class TPerfCounters
+{
+public:
+    enum TEvent
+    {
+        Cycles,
+        Instructions,
+        L1DMisses,
+        LLCMisses,
+        BranchMisses,
+        EventCount
+    };
+
+    TPerfCounters();
+    ~TPerfCounters();
+    TPerfCounters(const TPerfCounters&) = delete;
+    TPerfCounters& operator=(const TPerfCounters&) = delete;
+
+    bool available() const { return fds[Cycles] >= 0; }
+    bool has(TEvent e) const { return fds[e] >= 0; }
+
+    void start();
+    // Прибавляет к acc значения счётчиков с момента start()
+    void stop(uint64_t acc[EventCount]);
+
+    static const char* name(TEvent e);
+
+private:
+    int fds[EventCount];
+    uint64_t ids[EventCount];
+};
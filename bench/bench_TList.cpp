@@ -0,0 +1,325 @@
+#include <algorithm>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "TBench.h"
+#include "bench_TPolynom.h"
+#include "TCompressedList.h"
+#include "TList.h"
+#include "TListIO.h"
+
+using namespace std;
+
+// Элемент размером в строку кэша
+struct TBig
+{
+    int key;
+    char payload[60];
+
+    TBig(int k = 0) : key(k), payload()
+    {
+    }
+
+    bool operator==(const TBig& b) const { return key == b.key; }
+    bool operator<(const TBig& b) const { return key < b.key; }
+};
+
+static_assert(sizeof(TBig) == 64, "TBig must occupy one cache line");
+
+static int keyOf(int v) { return v; }
+static int keyOf(const TBig& v) { return v.key; }
+
+template <class C, class = void>
+struct THasPushBack : false_type {};
+template <class C>
+struct THasPushBack<C, void_t<decltype(declval<C&>().push_back(declval<typename C::value_type>()))>> : true_type {};
+
+template <class C, class = void>
+struct THasPushFront : false_type {};
+template <class C>
+struct THasPushFront<C, void_t<decltype(declval<C&>().push_front(declval<typename C::value_type>()))>> : true_type {};
+
+template <class C, class = void>
+struct THasSort : false_type {};
+template <class C>
+struct THasSort<C, void_t<decltype(declval<C&>().sort())>> : true_type {};
+
+template <class C>
+constexpr bool isForwardList = is_same_v<C, forward_list<typename C::value_type>>;
+
+// Контейнеры со вставкой/удалением в середине за O(n)
+template <class C>
+constexpr bool isArrayLike = is_same_v<C, vector<typename C::value_type>> || is_same_v<C, deque<typename C::value_type>>;
+
+// Для них квадратичные бенчмарки ограничены по размеру
+const size_t QuadraticLimit = 100000;
+
+static vector<int> randomKeys(size_t n)
+{
+    vector<int> res(n);
+    unsigned seed = 2024;
+    for (size_t i = 0; i < n; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        res[i] = int(seed >> 1);
+    }
+    return res;
+}
+
+template <class C>
+static C build(size_t n)
+{
+    C c;
+    if constexpr (isForwardList<C>)
+    {
+        for (size_t i = n; i-- > 0;)
+            c.push_front(typename C::value_type(int(i)));
+    }
+    else
+    {
+        for (size_t i = 0; i < n; i++)
+            c.push_back(typename C::value_type(int(i)));
+    }
+    return c;
+}
+
+template <class C>
+static void benchPushBack(TBenchState& st)
+{
+    C c;
+    st.start();
+    for (size_t i = 0; i < st.size(); i++)
+        c.push_back(typename C::value_type(int(i)));
+    st.stop();
+    doNotOptimize(c);
+}
+
+template <class C>
+static void benchPushFront(TBenchState& st)
+{
+    C c;
+    st.start();
+    for (size_t i = 0; i < st.size(); i++)
+        c.push_front(typename C::value_type(int(i)));
+    st.stop();
+    doNotOptimize(c);
+}
+
+// n вставок в середину контейнера из n элементов через один итератор
+template <class C>
+static void benchInsert(TBenchState& st)
+{
+    C c = build<C>(st.size());
+    auto it = c.begin();
+    advance(it, st.size() / 2);
+    st.start();
+    for (size_t i = 0; i < st.size(); i++)
+    {
+        if constexpr (isForwardList<C>)
+            it = c.insert_after(it, typename C::value_type(int(i)));
+        else
+            it = c.insert(it, typename C::value_type(int(i)));
+    }
+    st.stop();
+    doNotOptimize(c);
+}
+
+// Удаление каждого второго элемента проходом по итератору
+template <class C>
+static void benchErase(TBenchState& st)
+{
+    C c = build<C>(st.size());
+    st.start();
+    if constexpr (isForwardList<C>)
+    {
+        for (auto it = c.begin(); it != c.end() && next(it) != c.end(); ++it)
+            c.erase_after(it);
+    }
+    else
+    {
+        for (auto it = c.begin(); it != c.end();)
+        {
+            it = c.erase(it);
+            if (it != c.end())
+                ++it;
+        }
+    }
+    st.stop();
+    doNotOptimize(c);
+}
+
+// Поиск отсутствующего значения: полный проход со сравнением
+template <class C>
+static void benchFind(TBenchState& st)
+{
+    C c = build<C>(st.size());
+    typename C::value_type missing(-1);
+    st.start();
+    auto it = find(c.begin(), c.end(), missing);
+    st.stop();
+    doNotOptimize(it == c.end());
+}
+
+template <class C>
+static void benchTraverse(TBenchState& st)
+{
+    C c = build<C>(st.size());
+    st.start();
+    long long sum = 0;
+    for (const auto& v : c)
+        sum += keyOf(v);
+    st.stop();
+    doNotOptimize(sum);
+}
+
+template <class C>
+static void benchSort(TBenchState& st)
+{
+    vector<int> keys = randomKeys(st.size());
+    C c;
+    if constexpr (isForwardList<C>)
+        c.assign(keys.begin(), keys.end());
+    else
+    {
+        for (int k : keys)
+            c.push_back(typename C::value_type(k));
+    }
+    st.start();
+    if constexpr (THasSort<C>::value)
+        c.sort();
+    else
+        sort(c.begin(), c.end());
+    st.stop();
+    doNotOptimize(c);
+}
+
+template <class C>
+static void benchCopy(TBenchState& st)
+{
+    C c = build<C>(st.size());
+    st.start();
+    C copy(c);
+    st.stop();
+    doNotOptimize(copy);
+}
+
+static string numbersText(size_t n)
+{
+    stringstream ss;
+    ss << build<TList<int>>(n);
+    return ss.str();
+}
+
+// Чтение текстового дампа: operator>> на from_chars
+static void benchReadText(TBenchState& st)
+{
+    stringstream ss(numbersText(st.size()));
+    TList<int> l;
+    st.start();
+    ss >> l;
+    st.stop();
+    doNotOptimize(l);
+}
+
+// То же форматированным вводом iostream, элемент за элементом
+static void benchReadIostream(TBenchState& st)
+{
+    stringstream ss(numbersText(st.size()));
+    TList<int> l;
+    st.start();
+    int v;
+    while (ss >> v)
+        l.push_back(v);
+    st.stop();
+    doNotOptimize(l);
+}
+
+static void benchWriteText(TBenchState& st)
+{
+    TList<int> l = build<TList<int>>(st.size());
+    stringstream ss;
+    st.start();
+    ss << l;
+    st.stop();
+    doNotOptimize(ss);
+}
+
+static void benchWriteIostream(TBenchState& st)
+{
+    TList<int> l = build<TList<int>>(st.size());
+    stringstream ss;
+    st.start();
+    for (int v : l)
+        ss << v << ' ';
+    st.stop();
+    doNotOptimize(ss);
+}
+
+// Обход возрастающих 64-битных идентификаторов
+template <class C>
+static void benchTraverseIds(TBenchState& st)
+{
+    C c;
+    for (size_t i = 0; i < st.size(); i++)
+        c.push_back(uint64_t(i) * 3);
+    st.start();
+    uint64_t sum = 0;
+    for (uint64_t v : c)
+        sum += v;
+    st.stop();
+    doNotOptimize(sum);
+}
+
+template <class C>
+static void addAll(TBenchRunner& r, const string& name)
+{
+    for (size_t n = 100; n <= 10000000; n *= 10)
+    {
+        if constexpr (THasPushBack<C>::value)
+            r.add("push_back/" + name, n, benchPushBack<C>);
+        if constexpr (THasPushFront<C>::value)
+            r.add("push_front/" + name, n, benchPushFront<C>);
+        if (!isArrayLike<C> || n <= QuadraticLimit)
+        {
+            r.add("insert/" + name, n, benchInsert<C>);
+            r.add("erase/" + name, n, benchErase<C>);
+        }
+        r.add("find/" + name, n, benchFind<C>);
+        r.add("traverse/" + name, n, benchTraverse<C>);
+        r.add("sort/" + name, n, benchSort<C>);
+        r.add("copy/" + name, n, benchCopy<C>);
+    }
+}
+
+template <class E>
+static void addContainers(TBenchRunner& r, const string& elem)
+{
+    addAll<TList<E>>(r, "TList<" + elem + ">");
+    addAll<list<E>>(r, "std::list<" + elem + ">");
+    addAll<forward_list<E>>(r, "std::forward_list<" + elem + ">");
+    addAll<deque<E>>(r, "std::deque<" + elem + ">");
+    addAll<vector<E>>(r, "std::vector<" + elem + ">");
+}
+
+int main(int argc, char** argv)
+{
+    TBenchRunner r;
+    addContainers<int>(r, "int");
+    addContainers<TBig>(r, "TBig");
+    for (size_t n = 100; n <= 10000000; n *= 10)
+    {
+        r.add("read_text/TList<int>", n, benchReadText);
+        r.add("read_text/iostream", n, benchReadIostream);
+        r.add("write_text/TList<int>", n, benchWriteText);
+        r.add("write_text/iostream", n, benchWriteIostream);
+        r.add("traverse_ids/TList<uint64>", n, benchTraverseIds<TList<uint64_t>>);
+        r.add("traverse_ids/TCompressedList", n, benchTraverseIds<TCompressedList<uint64_t>>);
+    }
+    addPolynomBenchmarks(r);
+    return r.run(argc, argv);
+}
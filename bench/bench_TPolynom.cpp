@@ -0,0 +1,103 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include "bench_TPolynom.h"
+#include "TPolynom.h"
+
+using namespace std;
+
+static TPolynom randomPolynom(size_t n, unsigned maxExp, unsigned seed)
+{
+    TList<TMonom> l;
+    for (size_t i = 0; i < n; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        unsigned r = seed >> 4;
+        l.push_back(TMonom(1.0 + r % 7, r % (maxExp + 1), (r >> 9) % (maxExp + 1), (r >> 18) % (maxExp + 1)));
+    }
+    return TPolynom(std::move(l));
+}
+
+// Размер бенчмарка - число попарных произведений членов n * n
+template <TMulMethod Method>
+static void benchMul(TBenchState& st, unsigned maxExp)
+{
+    size_t n = size_t(std::sqrt(double(st.size())));
+    TPolynom p = randomPolynom(n, maxExp, 1), q = randomPolynom(n, maxExp, 2);
+    st.start();
+    TPolynom r = TPolynom::multiply(p, q, Method);
+    st.stop();
+    doNotOptimize(r);
+}
+
+// То же в parallel_multiply на всех ядрах
+static void benchParallelMul(TBenchState& st, unsigned maxExp)
+{
+    size_t n = size_t(std::sqrt(double(st.size())));
+    TPolynom p = randomPolynom(n, maxExp, 1), q = randomPolynom(n, maxExp, 2);
+    st.start();
+    TPolynom r = TPolynom::parallel_multiply(p, q);
+    st.stop();
+    doNotOptimize(r);
+}
+
+// Вычисление многочлена из 1000 членов в st.size() точках
+static vector<double> samplePoints(size_t n, double base)
+{
+    vector<double> res(n);
+    for (size_t i = 0; i < n; i++)
+        res[i] = base + 1e-4 * double(i % 1000);
+    return res;
+}
+
+static void benchEvalPointwise(TBenchState& st)
+{
+    TPolynom p = randomPolynom(1000, 20, 3);
+    vector<double> x = samplePoints(st.size(), 0.9), y = samplePoints(st.size(), -1.0), z = samplePoints(st.size(), 0.8);
+    vector<double> out(st.size());
+    st.start();
+    for (size_t i = 0; i < st.size(); i++)
+        out[i] = p(x[i], y[i], z[i]);
+    st.stop();
+    doNotOptimize(out);
+}
+
+static void benchEvalBatch(TBenchState& st)
+{
+    TPolynom p = randomPolynom(1000, 20, 3);
+    vector<double> x = samplePoints(st.size(), 0.9), y = samplePoints(st.size(), -1.0), z = samplePoints(st.size(), 0.8);
+    vector<double> out(st.size());
+    st.start();
+    p.evaluate(x.data(), y.data(), z.data(), st.size(), out.data());
+    st.stop();
+    doNotOptimize(out);
+}
+
+template <TMulMethod Method>
+static void addMethod(TBenchRunner& r, const string& name)
+{
+    for (size_t n = 100; n <= 3000; n *= n < 1000 ? 10 : 3)
+    {
+        // степени до 500 - произведение почти без совпадающих мономов
+        r.add("mul_sparse/" + name, n * n, [](TBenchState& st) { benchMul<Method>(st, 500); });
+        // степени до 8 - миллионы произведений на несколько тысяч мономов
+        r.add("mul_dense/" + name, n * n, [](TBenchState& st) { benchMul<Method>(st, 8); });
+    }
+}
+
+void addPolynomBenchmarks(TBenchRunner& r)
+{
+    addMethod<TMulMethod::Heap>(r, "heap");
+    addMethod<TMulMethod::Hash>(r, "hash");
+    addMethod<TMulMethod::Auto>(r, "auto");
+    for (size_t n = 100; n <= 3000; n *= n < 1000 ? 10 : 3)
+    {
+        r.add("mul_sparse/parallel", n * n, [](TBenchState& st) { benchParallelMul(st, 500); });
+        r.add("mul_dense/parallel", n * n, [](TBenchState& st) { benchParallelMul(st, 8); });
+    }
+    for (size_t n = 100; n <= 1000000; n *= 10)
+    {
+        r.add("eval/pointwise", n, benchEvalPointwise);
+        r.add("eval/batch", n, benchEvalBatch);
+    }
+}
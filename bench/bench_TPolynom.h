@@ -0,0 +1,5 @@
+#pragma once
+#include "TBench.h"
+
+// Регистрирует бенчмарки умножения TPolynom
+void addPolynomBenchmarks(TBenchRunner& r);
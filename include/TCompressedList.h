@@ -0,0 +1,306 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "TList.h"
+
+// Неубывающая последовательность беззнаковых целых в сжатом виде.
+// Значения делятся на блоки по BlockSize: блок хранит первое значение
+// как есть, а остальные - разностями с предыдущим, упакованными по
+// width бит, где width - длина наибольшей разности блока. Последние
+// (неполный блок) значения хранятся несжатыми до заполнения блока.
+// Обход распаковывает блок целиком в буфер итератора; распаковка и
+// восстановление префиксными суммами - простые циклы без ветвлений,
+// которые компилятор векторизует. Изменение только добавлением в конец.
+template <class T = uint64_t>
+class TCompressedList
+{
+    static_assert(std::is_unsigned_v<T>, "TCompressedList stores unsigned integers");
+
+public:
+    static constexpr size_t BlockSize = 128;
+
+private:
+    struct TBlock
+    {
+        T first;
+        T last;
+        uint64_t offset : 56;   // начало упакованных разностей в words
+        uint64_t width : 8;
+    };
+
+    std::vector<TBlock> blocks;
+    std::vector<uint64_t> words;
+    std::vector<T> tail;
+    size_t sz = 0;
+
+    static unsigned bitWidth(T v) noexcept
+    {
+        unsigned w = 0;
+        while (v)
+        {
+            w++;
+            v >>= 1;
+        }
+        return w;
+    }
+
+    static size_t wordsFor(unsigned width) noexcept
+    {
+        return ((BlockSize - 1) * width + 63) / 64;
+    }
+
+    // Сжимает заполненный tail в новый блок
+    void seal()
+    {
+        T deltas[BlockSize - 1];
+        T maxDelta = 0;
+        for (size_t i = 1; i < BlockSize; i++)
+        {
+            deltas[i - 1] = T(tail[i] - tail[i - 1]);
+            maxDelta |= deltas[i - 1];
+        }
+        unsigned w = bitWidth(maxDelta);
+        size_t off = words.size();
+        words.resize(off + wordsFor(w), 0);
+        uint64_t* out = words.data() + off;
+        for (size_t i = 0; i < BlockSize - 1 && w; i++)
+        {
+            size_t bit = i * w;
+            size_t shift = bit & 63;
+            out[bit >> 6] |= uint64_t(deltas[i]) << shift;
+            if (shift + w > 64)
+                out[(bit >> 6) + 1] |= uint64_t(deltas[i]) >> (64 - shift);
+        }
+        blocks.push_back({tail.front(), tail.back(), off, w});
+        tail.clear();
+    }
+
+    // Распаковка разностей ширины W; W известна при компиляции, поэтому
+    // сдвиги и маска постоянны и цикл разворачивается
+    template <unsigned W>
+    static void unpack(const uint64_t* in, T* out) noexcept
+    {
+        if constexpr (W == 0)
+        {
+            for (size_t i = 0; i < BlockSize - 1; i++)
+                out[i] = 0;
+        }
+        else
+        {
+            constexpr uint64_t mask = W == 64 ? ~uint64_t(0) : (uint64_t(1) << W) - 1;
+            for (size_t i = 0; i < BlockSize - 1; i++)
+            {
+                size_t bit = i * W;
+                size_t shift = bit & 63;
+                uint64_t v = in[bit >> 6] >> shift;
+                if (shift + W > 64)
+                    v |= in[(bit >> 6) + 1] << (64 - shift);
+                out[i] = T(v & mask);
+            }
+        }
+    }
+
+    using TUnpack = void (*)(const uint64_t*, T*) noexcept;
+
+    template <size_t... W>
+    static constexpr std::array<TUnpack, sizeof...(W)> unpackTable(std::index_sequence<W...>)
+    {
+        return {{&unpack<unsigned(W)>...}};
+    }
+
+    static constexpr std::array<TUnpack, sizeof(T) * 8 + 1> Unpackers = unpackTable(std::make_index_sequence<sizeof(T) * 8 + 1>());
+
+public:
+    // Распаковывает блок b в out[0..BlockSize)
+    void decode_block(size_t b, T* out) const
+    {
+        const TBlock& blk = blocks[b];
+        out[0] = blk.first;
+        Unpackers[blk.width](words.data() + blk.offset, out + 1);
+        for (size_t i = 1; i < BlockSize; i++)
+            out[i] += out[i - 1];
+    }
+
+    // Прямой итератор; несёт буфер распакованного блока, поэтому копировать
+    // его дороже обычного. Добавление в список делает итераторы недействительными.
+    class const_iterator
+    {
+        friend class TCompressedList;
+
+        const TCompressedList* pList = nullptr;
+        size_t block = 0;
+        size_t idx = 0;
+        T buf[BlockSize];
+
+        const_iterator(const TCompressedList* l, size_t b, size_t i) : pList(l), block(b), idx(i)
+        {
+            if (block < pList->blocks.size())
+                pList->decode_block(block, buf);
+        }
+
+        const T* data() const
+        {
+            return block < pList->blocks.size() ? buf : pList->tail.data();
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        const T& operator*() const { return data()[idx]; }
+        const T* operator->() const { return data() + idx; }
+
+        const_iterator& operator++()
+        {
+            if (++idx == BlockSize && block < pList->blocks.size())
+            {
+                idx = 0;
+                if (++block < pList->blocks.size())
+                    pList->decode_block(block, buf);
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.block == b.block && a.idx == b.idx; }
+        friend bool operator!=(const const_iterator& a, const const_iterator& b) { return !(a == b); }
+    };
+
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = const_iterator;
+
+    TCompressedList() = default;
+
+    template <class InputIt, class = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag,
+                                 typename std::iterator_traits<InputIt>::iterator_category>>>
+    TCompressedList(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    TCompressedList(std::initializer_list<T> il) : TCompressedList(il.begin(), il.end())
+    {
+    }
+
+    explicit TCompressedList(const TList<T>& l) : TCompressedList(l.begin(), l.end())
+    {
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0, 0); }
+    const_iterator end() const { return const_iterator(this, blocks.size(), tail.size()); }
+
+    bool empty() const noexcept { return sz == 0; }
+    size_t size() const noexcept { return sz; }
+    size_t block_count() const noexcept { return blocks.size(); }
+
+    // Память под данные (без учёта запаса в векторах)
+    size_t bytes_used() const noexcept
+    {
+        return blocks.size() * sizeof(TBlock) + words.size() * sizeof(uint64_t) + tail.size() * sizeof(T);
+    }
+
+    T front() const
+    {
+        if (!sz)
+            throw std::out_of_range("TCompressedList is empty");
+        return blocks.empty() ? tail.front() : blocks.front().first;
+    }
+
+    T back() const
+    {
+        if (!sz)
+            throw std::out_of_range("TCompressedList is empty");
+        return tail.empty() ? blocks.back().last : tail.back();
+    }
+
+    // Значения должны добавляться в неубывающем порядке
+    void push_back(T v)
+    {
+        if (sz && v < back())
+            throw std::invalid_argument("TCompressedList: values must be non-decreasing");
+        tail.push_back(v);
+        sz++;
+        if (tail.size() == BlockSize)
+            seal();
+    }
+
+    // Двоичный поиск блока по граничным значениям, затем распаковка одного блока
+    bool contains(T v) const
+    {
+        size_t lo = 0, hi = blocks.size();
+        while (lo < hi)
+        {
+            size_t mid = (lo + hi) / 2;
+            if (blocks[mid].last < v)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < blocks.size())
+        {
+            if (blocks[lo].first > v)
+                return false;
+            T buf[BlockSize];
+            decode_block(lo, buf);
+            for (T x : buf)
+                if (x == v)
+                    return true;
+            return false;
+        }
+        for (T x : tail)
+            if (x == v)
+                return true;
+        return false;
+    }
+
+    // Вызывает f для каждого значения; быстрее обхода итератором
+    template <class F>
+    void for_each(F f) const
+    {
+        T buf[BlockSize];
+        for (size_t b = 0; b < blocks.size(); b++)
+        {
+            decode_block(b, buf);
+            for (T x : buf)
+                f(x);
+        }
+        for (T x : tail)
+            f(x);
+    }
+
+    TList<T> to_list() const
+    {
+        TList<T> res;
+        res.reserve(sz);
+        for_each([&res](T x) { res.push_back(x); });
+        return res;
+    }
+
+    void clear() noexcept
+    {
+        blocks.clear();
+        words.clear();
+        tail.clear();
+        sz = 0;
+    }
+};
@@ -0,0 +1,181 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "TEpoch.h"
+
+// Неблокирующее упорядоченное множество (список Харриса).
+// insert, erase и contains можно вызывать из любого числа потоков.
+// Удаление логическое (пометка младшего бита ссылки pNext), физически
+// узлы вырезает любой проходящий поток одним CAS, а память освобождается
+// через TEpoch. contains не пишет в разделяемую память,
+// кроме собственной записи эпохи.
+template <class T, class Compare = std::less<T>>
+class TConcurrentList
+{
+    struct TNodeBase
+    {
+        std::atomic<uintptr_t> next{0};
+    };
+
+    struct TNode : TNodeBase
+    {
+        T key;
+
+        explicit TNode(const T& k) : key(k)
+        {
+        }
+    };
+
+    TNodeBase head;
+    Compare comp;
+
+    static bool marked(uintptr_t p) { return p & 1; }
+    static TNode* ptr(uintptr_t p) { return reinterpret_cast<TNode*>(p & ~uintptr_t(1)); }
+    static uintptr_t raw(TNode* p) { return reinterpret_cast<uintptr_t>(p); }
+
+    static void deleteNode(void* p)
+    {
+        delete static_cast<TNode*>(p);
+    }
+
+    bool less(const TNode* n, const T& key) const { return comp(n->key, key); }
+    bool equal(const TNode* n, const T& key) const { return !comp(n->key, key) && !comp(key, n->key); }
+
+    // Находит соседние непомеченные узлы left < key <= right, по пути
+    // вырезая цепочку помеченных узлов между ними. Вызывается под TGuard.
+    TNode* search(const T& key, TNodeBase*& left)
+    {
+        for (;;)
+        {
+            TNodeBase* prev = &head;
+            uintptr_t tNext = head.next.load(std::memory_order_acquire);
+            TNode* leftNext = nullptr;
+            TNode* t;
+            do
+            {
+                if (!marked(tNext))
+                {
+                    left = prev;
+                    leftNext = ptr(tNext);
+                }
+                t = ptr(tNext);
+                if (!t)
+                    break;
+                tNext = t->next.load(std::memory_order_acquire);
+                prev = t;
+            } while (marked(tNext) || less(t, key));
+            TNode* right = t;
+
+            if (leftNext != right)
+            {
+                uintptr_t expected = raw(leftNext);
+                if (!left->next.compare_exchange_strong(expected, raw(right), std::memory_order_acq_rel))
+                    continue;
+                // вырезанную цепочку освобождает только тот, чей CAS прошёл
+                for (TNode* p = leftNext; p != right;)
+                {
+                    TNode* next = ptr(p->next.load(std::memory_order_relaxed));
+                    TEpoch::retire(p, deleteNode);
+                    p = next;
+                }
+            }
+            if (right && marked(right->next.load(std::memory_order_acquire)))
+                continue;
+            return right;
+        }
+    }
+
+public:
+    TConcurrentList() = default;
+    explicit TConcurrentList(const Compare& c) : comp(c)
+    {
+    }
+
+    TConcurrentList(const TConcurrentList&) = delete;
+    TConcurrentList& operator=(const TConcurrentList&) = delete;
+
+    // Разрушать список можно, только когда к нему никто не обращается
+    ~TConcurrentList()
+    {
+        TNode* p = ptr(head.next.load(std::memory_order_relaxed));
+        while (p)
+        {
+            TNode* next = ptr(p->next.load(std::memory_order_relaxed));
+            delete p;
+            p = next;
+        }
+    }
+
+    // false, если ключ уже есть
+    bool insert(const T& key)
+    {
+        TEpoch::TGuard g;
+        TNode* n = nullptr;
+        for (;;)
+        {
+            TNodeBase* left = &head;
+            TNode* right = search(key, left);
+            if (right && equal(right, key))
+            {
+                delete n;
+                return false;
+            }
+            if (!n)
+                n = new TNode(key);
+            n->next.store(raw(right), std::memory_order_relaxed);
+            uintptr_t expected = raw(right);
+            if (left->next.compare_exchange_strong(expected, raw(n), std::memory_order_acq_rel))
+                return true;
+        }
+    }
+
+    // false, если ключа нет
+    bool erase(const T& key)
+    {
+        TEpoch::TGuard g;
+        TNodeBase* left = &head;
+        TNode* right;
+        uintptr_t rightNext;
+        for (;;)
+        {
+            right = search(key, left);
+            if (!right || !equal(right, key))
+                return false;
+            rightNext = right->next.load(std::memory_order_acquire);
+            if (!marked(rightNext) &&
+                right->next.compare_exchange_strong(rightNext, rightNext | 1, std::memory_order_acq_rel))
+                break;
+        }
+        uintptr_t expected = raw(right);
+        if (left->next.compare_exchange_strong(expected, rightNext, std::memory_order_acq_rel))
+            TEpoch::retire(right, deleteNode);
+        else
+            search(key, left);
+        return true;
+    }
+
+    bool contains(const T& key) const
+    {
+        TEpoch::TGuard g;
+        TNode* t = ptr(head.next.load(std::memory_order_acquire));
+        while (t && less(t, key))
+            t = ptr(t->next.load(std::memory_order_acquire));
+        return t && equal(t, key) && !marked(t->next.load(std::memory_order_acquire));
+    }
+
+    // Обход живых ключей по возрастанию. Без внешней синхронизации видит
+    // некоторое промежуточное состояние списка.
+    template <class F>
+    void for_each(F f) const
+    {
+        TEpoch::TGuard g;
+        for (TNode* t = ptr(head.next.load(std::memory_order_acquire)); t;)
+        {
+            uintptr_t next = t->next.load(std::memory_order_acquire);
+            if (!marked(next))
+                f(t->key);
+            t = ptr(next);
+        }
+    }
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+// Эпохальное освобождение памяти (EBR) для узловых контейнеров.
+// Читатель на время обхода структуры входит в критическую секцию
+// (TEpoch::TGuard), объявляя текущую глобальную эпоху; это одна запись
+// в собственную строку кэша потока, без атомарных RMW на каждом шаге.
+// Писатель, исключивший узел из структуры, передаёт его в retire();
+// узел освобождается, когда глобальная эпоха продвинется на два шага,
+// то есть все читатели, которые могли его видеть, уже вышли.
+class TEpoch
+{
+public:
+    // Вход и выход из критической секции читателя; допускается вложенность
+    static void enter();
+    static void exit();
+
+    // p уже недостижим из структуры; del(p) будет вызван после грейс-периода
+    static void retire(void* p, void (*del)(void*));
+
+    template <class T>
+    static void retire(T* p)
+    {
+        retire(p, [](void* q) { delete static_cast<T*>(q); });
+    }
+
+    // Пытается продвинуть эпоху и освободить созревшие узлы текущего потока
+    static void collect();
+
+    // Ждёт окончания всех критических секций, начатых до вызова, и
+    // освобождает созревшие узлы текущего потока. Внутри секции вызывать нельзя.
+    static void synchronize();
+
+    static uint64_t current();
+
+    class TGuard
+    {
+    public:
+        TGuard() { enter(); }
+        ~TGuard() { exit(); }
+        TGuard(const TGuard&) = delete;
+        TGuard& operator=(const TGuard&) = delete;
+    };
+};
@@ -0,0 +1,264 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+// Звено интрузивного списка, встраиваемое в элемент. Копирование элемента
+// не копирует связи: копия не состоит ни в одном списке.
+struct TListHook
+{
+    TListHook* pPrev = nullptr;
+    TListHook* pNext = nullptr;
+    const void* pList = nullptr;    // список, в котором звено состоит
+
+    TListHook() = default;
+
+    TListHook(const TListHook&)
+    {
+    }
+
+    TListHook& operator=(const TListHook&)
+    {
+        return *this;
+    }
+
+    bool is_linked() const { return pNext != nullptr; }
+};
+
+template <class T, TListHook T::*Hook> class TIntrusiveList;
+
+template <class T, TListHook T::*Hook, bool Const>
+class TIntrusiveIterator
+{
+    template <class U, TListHook U::*> friend class TIntrusiveList;
+    template <class U, TListHook U::*, bool> friend class TIntrusiveIterator;
+
+    using TList = TIntrusiveList<T, Hook>;
+
+    TListHook* pHook = nullptr;
+
+    explicit TIntrusiveIterator(TListHook* h) : pHook(h)
+    {
+    }
+
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    TIntrusiveIterator() = default;
+
+    template <bool C = Const, class = std::enable_if_t<C>>
+    TIntrusiveIterator(const TIntrusiveIterator<T, Hook, false>& it) : pHook(it.pHook)
+    {
+    }
+
+    reference operator*() const { return *TList::owner(pHook); }
+    pointer operator->() const { return TList::owner(pHook); }
+
+    TIntrusiveIterator& operator++()
+    {
+        pHook = pHook->pNext;
+        return *this;
+    }
+
+    TIntrusiveIterator operator++(int)
+    {
+        TIntrusiveIterator tmp = *this;
+        pHook = pHook->pNext;
+        return tmp;
+    }
+
+    TIntrusiveIterator& operator--()
+    {
+        pHook = pHook->pPrev;
+        return *this;
+    }
+
+    TIntrusiveIterator operator--(int)
+    {
+        TIntrusiveIterator tmp = *this;
+        pHook = pHook->pPrev;
+        return tmp;
+    }
+
+    friend bool operator==(const TIntrusiveIterator& a, const TIntrusiveIterator& b) { return a.pHook == b.pHook; }
+    friend bool operator!=(const TIntrusiveIterator& a, const TIntrusiveIterator& b) { return a.pHook != b.pHook; }
+};
+
+// Интрузивный двусвязный список: элемент сам содержит звено (член Hook),
+// поэтому вставка и удаление не выделяют памяти. Список не владеет
+// элементами: они должны жить, пока состоят в списке, и разрушение списка
+// лишь отвязывает их. Элемент с несколькими звеньями может одновременно
+// состоять в нескольких списках, по одному на звено:
+//
+//     struct TSession { TListHook stateHook, lruHook; };
+//     TIntrusiveList<TSession, &TSession::stateHook> idle, active;
+//     active.splice(active.end(), idle, idle.iterator_to(s));
+template <class T, TListHook T::*Hook>
+class TIntrusiveList
+{
+    template <class U, TListHook U::*, bool> friend class TIntrusiveIterator;
+
+    TListHook head;
+    size_t sz = 0;
+
+    // Смещение звена внутри T (аналог offsetof для указателя на член).
+    // Вычисляется один раз на статическом буфере размера и выравнивания T.
+    static std::ptrdiff_t hookOffset() noexcept
+    {
+        static const std::ptrdiff_t off = [] {
+            alignas(T) static unsigned char storage[sizeof(T)];
+            const T* probe = reinterpret_cast<const T*>(storage);
+            return reinterpret_cast<const char*>(&(probe->*Hook)) - reinterpret_cast<const char*>(probe);
+        }();
+        return off;
+    }
+
+    static T* owner(TListHook* h)
+    {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(h) - hookOffset());
+    }
+
+    static TListHook* hookOf(T& v)
+    {
+        return &(v.*Hook);
+    }
+
+    void checkOwned(const TListHook* h) const
+    {
+        if (h->pList != this)
+            throw std::logic_error("TIntrusiveList: element is not linked in this list");
+    }
+
+    void link(TListHook* pos, TListHook* h)
+    {
+        if (h->is_linked())
+            throw std::logic_error("TIntrusiveList: element is already linked by this hook");
+        h->pList = this;
+        h->pNext = pos;
+        h->pPrev = pos->pPrev;
+        pos->pPrev->pNext = h;
+        pos->pPrev = h;
+        sz++;
+    }
+
+    void unlink(TListHook* h) noexcept
+    {
+        h->pPrev->pNext = h->pNext;
+        h->pNext->pPrev = h->pPrev;
+        h->pPrev = h->pNext = nullptr;
+        h->pList = nullptr;
+        sz--;
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = TIntrusiveIterator<T, Hook, false>;
+    using const_iterator = TIntrusiveIterator<T, Hook, true>;
+
+    TIntrusiveList()
+    {
+        head.pPrev = head.pNext = &head;
+    }
+
+    TIntrusiveList(const TIntrusiveList&) = delete;
+    TIntrusiveList& operator=(const TIntrusiveList&) = delete;
+
+    ~TIntrusiveList()
+    {
+        clear();
+    }
+
+    iterator begin() noexcept { return iterator(head.pNext); }
+    iterator end() noexcept { return iterator(&head); }
+    const_iterator begin() const noexcept { return const_iterator(const_cast<TListHook*>(head.pNext)); }
+    const_iterator end() const noexcept { return const_iterator(const_cast<TListHook*>(&head)); }
+
+    bool empty() const noexcept { return sz == 0; }
+    size_t size() const noexcept { return sz; }
+
+    T& front()
+    {
+        if (!sz)
+            throw std::out_of_range("TIntrusiveList is empty");
+        return *owner(head.pNext);
+    }
+
+    T& back()
+    {
+        if (!sz)
+            throw std::out_of_range("TIntrusiveList is empty");
+        return *owner(head.pPrev);
+    }
+
+    // Итератор на элемент, про который известно, что он в этом списке
+    static iterator iterator_to(T& v) noexcept
+    {
+        return iterator(hookOf(v));
+    }
+
+    iterator insert(const_iterator pos, T& v)
+    {
+        link(pos.pHook, hookOf(v));
+        return iterator(hookOf(v));
+    }
+
+    void push_front(T& v) { link(head.pNext, hookOf(v)); }
+    void push_back(T& v) { link(&head, hookOf(v)); }
+
+    iterator erase(const_iterator pos)
+    {
+        if (pos.pHook == &head)
+            throw std::out_of_range("TIntrusiveList: erase(end())");
+        checkOwned(pos.pHook);
+        TListHook* next = pos.pHook->pNext;
+        unlink(pos.pHook);
+        return iterator(next);
+    }
+
+    // Отвязывает элемент этого списка за O(1). Элемент другого списка на
+    // том же звене или не связанный ни с каким - logic_error.
+    void remove(T& v)
+    {
+        erase(iterator_to(v));
+    }
+
+    void pop_front()
+    {
+        if (!sz)
+            throw std::out_of_range("TIntrusiveList is empty");
+        unlink(head.pNext);
+    }
+
+    void pop_back()
+    {
+        if (!sz)
+            throw std::out_of_range("TIntrusiveList is empty");
+        unlink(head.pPrev);
+    }
+
+    // Переносит элемент it из other перед pos
+    void splice(const_iterator pos, TIntrusiveList& other, const_iterator it)
+    {
+        TListHook* h = it.pHook;
+        other.checkOwned(h);
+        if (pos.pHook == h)
+            return;
+        other.unlink(h);
+        link(pos.pHook, h);
+    }
+
+    void clear() noexcept
+    {
+        while (sz)
+            unlink(head.pNext);
+    }
+};
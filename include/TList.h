@@ -1 +1,1586 @@
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "TParallel.h"
+
+// Пул узлов фиксированного размера.
+// Память берётся слябами (пачками узлов) у memory_resource, освобождённые
+// узлы не возвращаются ему, а складываются в интрузивный список свободных
+// и переиспользуются следующими вставками.
+template <class TNode>
+class TNodePool
+{
+    union TSlot
+    {
+        TSlot* pNext;
+        alignas(TNode) unsigned char buf[sizeof(TNode)];
+    };
+
+    struct TSlab
+    {
+        TSlab* pNext;
+        size_t count;
+        std::pmr::memory_resource* res;     // откуда взят, см. absorb
+    };
+
+    static constexpr size_t SlotAlign = alignof(TSlot) > alignof(TSlab) ? alignof(TSlot) : alignof(TSlab);
+    static constexpr size_t HeaderSize = (sizeof(TSlab) + alignof(TSlot) - 1) / alignof(TSlot) * alignof(TSlot);
+    static constexpr size_t MinSlab = 16;
+    static constexpr size_t MaxSlab = 4096;
+
+    TSlot* pFree = nullptr;     // список освобождённых узлов
+    TSlot* pFreeTail = nullptr;
+    TSlot* pBump = nullptr;     // ещё не выданная часть последнего сляба
+    TSlot* pBumpEnd = nullptr;
+    TSlab* pSlabs = nullptr;
+    TSlab* pSlabsTail = nullptr;
+    size_t nextSlab = MinSlab;
+    std::pmr::memory_resource* res;
+
+    static TSlot* slots(TSlab* s)
+    {
+        return reinterpret_cast<TSlot*>(reinterpret_cast<unsigned char*>(s) + HeaderSize);
+    }
+
+    void grow(size_t count)
+    {
+        if (count > (std::numeric_limits<size_t>::max() - HeaderSize) / sizeof(TSlot))
+            throw std::length_error("TNodePool: slab size overflow");
+        void* mem = res->allocate(HeaderSize + count * sizeof(TSlot), SlotAlign);
+        TSlab* s = static_cast<TSlab*>(mem);
+        s->pNext = pSlabs;
+        s->count = count;
+        s->res = res;
+        if (!pSlabs)
+            pSlabsTail = s;
+        pSlabs = s;
+        // хвост прежнего сляба не теряем
+        while (pBump != pBumpEnd)
+            deallocate(pBump++);
+        pBump = slots(s);
+        pBumpEnd = pBump + count;
+    }
+
+    void release()
+    {
+        while (pSlabs)
+        {
+            TSlab* s = pSlabs;
+            pSlabs = s->pNext;
+            s->res->deallocate(s, HeaderSize + s->count * sizeof(TSlot), SlotAlign);
+        }
+        pSlabsTail = nullptr;
+        pFree = pFreeTail = pBump = pBumpEnd = nullptr;
+        nextSlab = MinSlab;
+    }
+
+public:
+    // Пул, поглотивший этот (см. absorb). Владельцы узлов из разных пулов
+    // после splice держат ссылку на поглощённый пул и переходят по ней.
+    std::shared_ptr<TNodePool> pForward;
+
+    explicit TNodePool(std::pmr::memory_resource* r = std::pmr::get_default_resource()) : res(r)
+    {
+    }
+
+    TNodePool(const TNodePool&) = delete;
+    TNodePool& operator=(const TNodePool&) = delete;
+
+    TNodePool(TNodePool&& other) noexcept : res(other.res)
+    {
+        swap(other);
+    }
+
+    TNodePool& operator=(TNodePool&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~TNodePool()
+    {
+        release();
+    }
+
+    void swap(TNodePool& other) noexcept
+    {
+        std::swap(pFree, other.pFree);
+        std::swap(pFreeTail, other.pFreeTail);
+        std::swap(pBump, other.pBump);
+        std::swap(pBumpEnd, other.pBumpEnd);
+        std::swap(pSlabs, other.pSlabs);
+        std::swap(pSlabsTail, other.pSlabsTail);
+        std::swap(nextSlab, other.nextSlab);
+        std::swap(res, other.res);
+        std::swap(pForward, other.pForward);
+    }
+
+    void* allocate()
+    {
+        if (pFree)
+        {
+            TSlot* p = pFree;
+            pFree = p->pNext;
+            if (!pFree)
+                pFreeTail = nullptr;
+            return p;
+        }
+        if (pBump == pBumpEnd)
+        {
+            grow(nextSlab);
+            if (nextSlab < MaxSlab)
+                nextSlab *= 2;
+        }
+        return pBump++;
+    }
+
+    void deallocate(void* p) noexcept
+    {
+        TSlot* s = static_cast<TSlot*>(p);
+        s->pNext = pFree;
+        if (!pFree)
+            pFreeTail = s;
+        pFree = s;
+    }
+
+    std::pmr::memory_resource* resource() const noexcept
+    {
+        return res;
+    }
+
+    // Забирает все слябы и свободные узлы other за O(1); other остаётся пустым.
+    // Каждый сляб помнит свой memory_resource, поэтому пулы могут быть
+    // построены на разных ресурсах.
+    // Нетронутый остаток последнего сляба меньшего из пулов не используется
+    // до освобождения пула.
+    void absorb(TNodePool& other) noexcept
+    {
+        if (other.pSlabs)
+        {
+            if (pSlabs)
+                pSlabsTail->pNext = other.pSlabs;
+            else
+                pSlabs = other.pSlabs;
+            pSlabsTail = other.pSlabsTail;
+        }
+        if (other.pFree)
+        {
+            other.pFreeTail->pNext = pFree;
+            if (!pFree)
+                pFreeTail = other.pFreeTail;
+            pFree = other.pFree;
+        }
+        if (other.pBumpEnd - other.pBump > pBumpEnd - pBump)
+        {
+            pBump = other.pBump;
+            pBumpEnd = other.pBumpEnd;
+        }
+        other.pSlabs = other.pSlabsTail = nullptr;
+        other.pFree = other.pFreeTail = other.pBump = other.pBumpEnd = nullptr;
+    }
+
+    // Гарантирует, что следующие n вызовов allocate() не пойдут в кучу.
+    // Узлы списка свободных засчитываются и выдаются первыми, поэтому одним
+    // блоком выделяется только недостающее: подряд в памяти n узлов лягут
+    // лишь в пуле без освобождённых узлов.
+    void reserve(size_t n)
+    {
+        size_t avail = static_cast<size_t>(pBumpEnd - pBump);
+        for (TSlot* p = pFree; p && avail < n; p = p->pNext)
+            avail++;
+        if (avail < n)
+            grow(n - avail);
+    }
+
+    // Число узлов во всех слябах (занятых и свободных)
+    size_t capacity() const
+    {
+        size_t res = 0;
+        for (TSlab* s = pSlabs; s; s = s->pNext)
+            res += s->count;
+        return res;
+    }
+};
+
+struct TListNodeBase
+{
+    TListNodeBase* pPrev;
+    TListNodeBase* pNext;
+};
+
+template <class T>
+struct TListNode : TListNodeBase
+{
+    T val;
+
+    template <class... Args>
+    explicit TListNode(Args&&... args) : val(std::forward<Args>(args)...)
+    {
+    }
+};
+
+template <class T> class TList;
+
+template <class T, bool Const>
+class TListIterator
+{
+    template <class> friend class TList;
+    template <class, bool> friend class TListIterator;
+
+    using TNode = TListNode<T>;
+    using TBase = std::conditional_t<Const, const TListNodeBase, TListNodeBase>;
+
+    TBase* pNode = nullptr;
+
+    explicit TListIterator(TBase* p) : pNode(p)
+    {
+    }
+
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    TListIterator() = default;
+
+    template <bool C = Const, class = std::enable_if_t<C>>
+    TListIterator(const TListIterator<T, false>& it) : pNode(it.pNode)
+    {
+    }
+
+    reference operator*() const
+    {
+        return static_cast<std::conditional_t<Const, const TNode*, TNode*>>(pNode)->val;
+    }
+
+    pointer operator->() const
+    {
+        return &**this;
+    }
+
+    TListIterator& operator++()
+    {
+        pNode = pNode->pNext;
+        return *this;
+    }
+
+    TListIterator operator++(int)
+    {
+        TListIterator tmp = *this;
+        pNode = pNode->pNext;
+        return tmp;
+    }
+
+    TListIterator& operator--()
+    {
+        pNode = pNode->pPrev;
+        return *this;
+    }
+
+    TListIterator operator--(int)
+    {
+        TListIterator tmp = *this;
+        pNode = pNode->pPrev;
+        return tmp;
+    }
+
+    friend bool operator==(const TListIterator& a, const TListIterator& b)
+    {
+        return a.pNode == b.pNode;
+    }
+
+    friend bool operator!=(const TListIterator& a, const TListIterator& b)
+    {
+        return a.pNode != b.pNode;
+    }
+};
+
+// Двусвязный кольцевой список с фиктивным узлом.
+// Узлы выделяются из собственного пула списка (TNodePool), поэтому
+// вставка и удаление в установившемся режиме не обращаются к куче.
+// splice, split_at и concat перевешивают узлы между списками без
+// копирования; после этого списки могут разделять один пул, и менять
+// их одновременно из разных потоков нельзя.
+// Слябы пула и сам пул берутся у std::pmr::memory_resource списка.
+// На monotonic_buffer_resource разрушение списка тривиально
+// разрушаемых элементов не обходит узлы и ничего не освобождает по
+// одному. Ресурс должен пережить все списки, куда попали его узлы
+// (перемещающий конструктор, swap и splice переносят узлы вместе с их
+// памятью; перемещающее присваивание между разными ресурсами переносит
+// элементы поштучно).
+template <class T>
+class TList
+{
+    using TNode = TListNode<T>;
+    using TPool = TNodePool<TNode>;
+
+    TListNodeBase head;
+    size_t sz = 0;
+    std::shared_ptr<TPool> pPool;
+    std::pmr::memory_resource* res;
+
+    TPool& nodePool()
+    {
+        if (!pPool)
+            pPool = std::allocate_shared<TPool>(std::pmr::polymorphic_allocator<TPool>(res), res);
+        while (pPool->pForward)
+            pPool = pPool->pForward;
+        return *pPool;
+    }
+
+    // Узлы other переходят к *this, поэтому оба списка переводятся на один пул
+    void sharePool(TList& other)
+    {
+        if (!other.pPool)
+            return;
+        TPool& mine = nodePool();
+        TPool& theirs = other.nodePool();
+        if (&mine == &theirs)
+            return;
+        mine.absorb(theirs);
+        theirs.pForward = pPool;
+        other.pPool = pPool;
+    }
+
+    template <class... Args>
+    TNode* createNode(Args&&... args)
+    {
+        TPool& pool = nodePool();
+        void* mem = pool.allocate();
+        try
+        {
+            return ::new (mem) TNode(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            pool.deallocate(mem);
+            throw;
+        }
+    }
+
+    void destroyNode(TPool& pool, TListNodeBase* p) noexcept
+    {
+        TNode* n = static_cast<TNode*>(p);
+        n->~TNode();
+        pool.deallocate(n);
+    }
+
+    static const T& value(const TListNodeBase* p) noexcept
+    {
+        return static_cast<const TNode*>(p)->val;
+    }
+
+    // Восходящая сортировка слиянием односвязной цепочки по pNext
+    // (завершается nullptr). Узлы только перевешиваются, доп. память O(1).
+    // При равенстве первым идёт элемент из левой серии, поэтому сортировка
+    // устойчива.
+    template <class Compare>
+    static TListNodeBase* sortChain(TListNodeBase* list, Compare& comp)
+    {
+        for (size_t width = 1;; width *= 2)
+        {
+            TListNodeBase* p = list;
+            TListNodeBase* tail = nullptr;
+            size_t merges = 0;
+            list = nullptr;
+            while (p)
+            {
+                merges++;
+                TListNodeBase* q = p;
+                size_t psize = 0;
+                while (psize < width && q)
+                {
+                    q = q->pNext;
+                    psize++;
+                }
+                size_t qsize = width;
+                while (psize || (qsize && q))
+                {
+                    TListNodeBase* e;
+                    if (!psize)
+                    {
+                        e = q;
+                        q = q->pNext;
+                        qsize--;
+                    }
+                    else if (!qsize || !q || !comp(value(q), value(p)))
+                    {
+                        e = p;
+                        p = p->pNext;
+                        psize--;
+                    }
+                    else
+                    {
+                        e = q;
+                        q = q->pNext;
+                        qsize--;
+                    }
+                    if (tail)
+                        tail->pNext = e;
+                    else
+                        list = e;
+                    tail = e;
+                }
+                p = q;
+            }
+            tail->pNext = nullptr;
+            if (merges <= 1)
+                return list;
+        }
+    }
+
+    // Устойчивое слияние двух отсортированных цепочек
+    template <class Compare>
+    static TListNodeBase* mergeChains(TListNodeBase* a, TListNodeBase* b, Compare& comp)
+    {
+        TListNodeBase res;
+        TListNodeBase* tail = &res;
+        while (a && b)
+        {
+            if (comp(value(b), value(a)))
+            {
+                tail->pNext = b;
+                b = b->pNext;
+            }
+            else
+            {
+                tail->pNext = a;
+                a = a->pNext;
+            }
+            tail = tail->pNext;
+        }
+        tail->pNext = a ? a : b;
+        return res.pNext;
+    }
+
+    // Замыкает цепочку по pNext обратно в кольцо и восстанавливает pPrev
+    void relinkChain(TListNodeBase* list) noexcept
+    {
+        TListNodeBase* prev = &head;
+        for (TListNodeBase* p = list; p; p = p->pNext)
+        {
+            p->pPrev = prev;
+            prev->pNext = p;
+            prev = p;
+        }
+        prev->pNext = &head;
+        head.pPrev = prev;
+    }
+
+    // Пустой список на том же пуле: его узлы вклеиваются без слияния пулов
+    TList sibling()
+    {
+        nodePool();
+        TList tmp(res);
+        tmp.pPool = pPool;
+        return tmp;
+    }
+
+    // Вклеивает весь tmp перед pos, возвращает итератор на первый вклеенный
+    TListIterator<T, false> spliceAll(TListIterator<T, true> pos, TList& tmp)
+    {
+        TListIterator<T, false> first(const_cast<TListNodeBase*>(pos.pNode));
+        if (tmp.sz)
+        {
+            first = tmp.begin();
+            splice(pos, tmp);
+        }
+        return first;
+    }
+
+    // Число узлов в [first, last)
+    static size_t count(const TListNodeBase* first, const TListNodeBase* last) noexcept
+    {
+        size_t n = 0;
+        for (; first != last; first = first->pNext)
+            n++;
+        return n;
+    }
+
+    // Вставляет узел p перед pos
+    void link(TListNodeBase* pos, TListNodeBase* p) noexcept
+    {
+        p->pNext = pos;
+        p->pPrev = pos->pPrev;
+        pos->pPrev->pNext = p;
+        pos->pPrev = p;
+        sz++;
+    }
+
+    void unlink(TListNodeBase* p) noexcept
+    {
+        p->pPrev->pNext = p->pNext;
+        p->pNext->pPrev = p->pPrev;
+        sz--;
+    }
+
+    void resetHead() noexcept
+    {
+        head.pPrev = head.pNext = &head;
+        sz = 0;
+    }
+
+    // Переносит цепочку узлов из other в пустой *this вместе с пулом
+    void steal(TList& other) noexcept
+    {
+        if (other.sz)
+        {
+            head.pNext = other.head.pNext;
+            head.pPrev = other.head.pPrev;
+            head.pNext->pPrev = &head;
+            head.pPrev->pNext = &head;
+            sz = other.sz;
+        }
+        else
+            resetHead();
+        pPool = std::move(other.pPool);
+        res = other.res;
+        other.resetHead();
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = TListIterator<T, false>;
+    using const_iterator = TListIterator<T, true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    TList() : TList(std::pmr::get_default_resource())
+    {
+    }
+
+    explicit TList(std::pmr::memory_resource* r) : res(r)
+    {
+        resetHead();
+    }
+
+    explicit TList(size_t n, const T& val = T(), std::pmr::memory_resource* r = std::pmr::get_default_resource()) : res(r)
+    {
+        resetHead();
+        reserve(n);
+        for (size_t i = 0; i < n; i++)
+            push_back(val);
+    }
+
+    // При известной длине диапазона (итераторы произвольного доступа) все
+    // узлы берутся одним блоком и лежат в памяти в порядке обхода
+    template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    TList(InputIt first, InputIt last, std::pmr::memory_resource* r = std::pmr::get_default_resource()) : res(r)
+    {
+        resetHead();
+        insert(end(), first, last);
+    }
+
+    TList(std::initializer_list<T> il, std::pmr::memory_resource* r = std::pmr::get_default_resource())
+        : TList(il.begin(), il.end(), r)
+    {
+    }
+
+    // Как и у std::pmr-контейнеров, копия по умолчанию использует ресурс
+    // по умолчанию, а не ресурс оригинала
+    TList(const TList& other, std::pmr::memory_resource* r = std::pmr::get_default_resource()) : res(r)
+    {
+        resetHead();
+        reserve(other.sz);
+        for (const T& v : other)
+            push_back(v);
+    }
+
+    TList(TList&& other) noexcept
+    {
+        steal(other);
+    }
+
+    ~TList()
+    {
+        // память узлов целиком освободит пул, если он больше ни с кем не
+        // разделён; иначе узлы надо вернуть в общий пул
+        if constexpr (std::is_trivially_destructible_v<T>)
+        {
+            if (!pPool || (pPool.use_count() == 1 && !pPool->pForward))
+                return;
+        }
+        clear();
+    }
+
+    TList& operator=(const TList& other)
+    {
+        if (this != &other)
+        {
+            TList tmp(other, res);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    TList& operator=(TList&& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            if (res == other.res)
+                steal(other);
+            else
+            {
+                reserve(other.sz);
+                for (T& v : other)
+                    push_back(std::move(v));
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    void swap(TList& other) noexcept
+    {
+        TList tmp(std::move(other));
+        other.steal(*this);
+        steal(tmp);
+    }
+
+    iterator begin() noexcept { return iterator(head.pNext); }
+    iterator end() noexcept { return iterator(&head); }
+    const_iterator begin() const noexcept { return const_iterator(head.pNext); }
+    const_iterator end() const noexcept { return const_iterator(&head); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    bool empty() const noexcept { return sz == 0; }
+    size_t size() const noexcept { return sz; }
+    std::pmr::memory_resource* resource() const noexcept { return res; }
+
+    T& front()
+    {
+        if (!sz)
+            throw std::out_of_range("TList is empty");
+        return static_cast<TNode*>(head.pNext)->val;
+    }
+
+    const T& front() const
+    {
+        if (!sz)
+            throw std::out_of_range("TList is empty");
+        return static_cast<const TNode*>(head.pNext)->val;
+    }
+
+    T& back()
+    {
+        if (!sz)
+            throw std::out_of_range("TList is empty");
+        return static_cast<TNode*>(head.pPrev)->val;
+    }
+
+    const T& back() const
+    {
+        if (!sz)
+            throw std::out_of_range("TList is empty");
+        return static_cast<const TNode*>(head.pPrev)->val;
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args)
+    {
+        TNode* p = createNode(std::forward<Args>(args)...);
+        link(const_cast<TListNodeBase*>(pos.pNode), p);
+        return iterator(p);
+    }
+
+    iterator insert(const_iterator pos, const T& val) { return emplace(pos, val); }
+    iterator insert(const_iterator pos, T&& val) { return emplace(pos, std::move(val)); }
+
+    // Вставка диапазона перед pos. Элементы собираются во временный список
+    // на том же пуле и вклеиваются splice'ом, поэтому при исключении *this
+    // не меняется. Узлы резервируются заранее, но сначала берутся
+    // освобождённые, так что подряд в памяти вставка ляжет только в пуле
+    // без них. Возвращает итератор на первый вставленный элемент.
+    template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    iterator insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        TList tmp = sibling();
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::random_access_iterator_tag, Category>)
+            tmp.nodePool().reserve(static_cast<size_t>(last - first));
+        for (; first != last; ++first)
+            tmp.emplace_back(*first);
+        return spliceAll(pos, tmp);
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<T> il)
+    {
+        return insert(pos, il.begin(), il.end());
+    }
+
+    iterator insert(const_iterator pos, size_t n, const T& val)
+    {
+        TList tmp = sibling();
+        tmp.nodePool().reserve(n);
+        for (size_t i = 0; i < n; i++)
+            tmp.emplace_back(val);
+        return spliceAll(pos, tmp);
+    }
+
+    // Существующие узлы переиспользуются, недостающие берутся одним блоком
+    template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    void assign(InputIt first, InputIt last)
+    {
+        iterator it = begin();
+        for (; it != end() && first != last; ++it, ++first)
+            *it = *first;
+        if (first == last)
+            erase(it, end());
+        else
+            insert(end(), first, last);
+    }
+
+    void assign(std::initializer_list<T> il)
+    {
+        assign(il.begin(), il.end());
+    }
+
+    void assign(size_t n, const T& val)
+    {
+        iterator it = begin();
+        for (; it != end() && n; ++it, --n)
+            *it = val;
+        if (!n)
+            erase(it, end());
+        else
+            insert(end(), n, val);
+    }
+
+    template <class... Args>
+    T& emplace_front(Args&&... args) { return *emplace(begin(), std::forward<Args>(args)...); }
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) { return *emplace(end(), std::forward<Args>(args)...); }
+
+    void push_front(const T& val) { emplace(begin(), val); }
+    void push_front(T&& val) { emplace(begin(), std::move(val)); }
+    void push_back(const T& val) { emplace(end(), val); }
+    void push_back(T&& val) { emplace(end(), std::move(val)); }
+
+    iterator erase(const_iterator pos)
+    {
+        TListNodeBase* p = const_cast<TListNodeBase*>(pos.pNode);
+        if (p == &head)
+            throw std::out_of_range("TList: erase(end())");
+        TListNodeBase* next = p->pNext;
+        unlink(p);
+        destroyNode(nodePool(), p);
+        return iterator(next);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        while (first != last)
+            first = erase(first);
+        return iterator(const_cast<TListNodeBase*>(last.pNode));
+    }
+
+    void pop_front()
+    {
+        if (!sz)
+            throw std::out_of_range("TList is empty");
+        erase(begin());
+    }
+
+    void pop_back()
+    {
+        if (!sz)
+            throw std::out_of_range("TList is empty");
+        erase(iterator(head.pPrev));
+    }
+
+    // Узлы возвращаются в пул, память слябов остаётся за списком
+    void clear() noexcept
+    {
+        if (!sz)
+            return;
+        TPool& pool = nodePool();
+        TListNodeBase* p = head.pNext;
+        while (p != &head)
+        {
+            TListNodeBase* next = p->pNext;
+            destroyNode(pool, p);
+            p = next;
+        }
+        resetHead();
+    }
+
+    // Переносит все элементы в новый непрерывный блок узлов в порядке обхода
+    // и отпускает старый пул, возвращая локальность после долгой серии
+    // вставок и удалений. Делает недействительными ВСЕ итераторы, указатели
+    // и ссылки на элементы. Память старых узлов освобождается, когда её не
+    // держат другие списки (после split_at/splice пул бывает общим).
+    // Пиковое потребление - два экземпляра узлов. Если перемещение T может
+    // бросить исключение, элементы копируются, и при ошибке список не меняется.
+    void compact()
+    {
+        if (!sz)
+        {
+            pPool.reset();
+            return;
+        }
+        std::shared_ptr<TPool> fresh = std::allocate_shared<TPool>(std::pmr::polymorphic_allocator<TPool>(res), res);
+        fresh->reserve(sz);
+        TListNodeBase chain;
+        TListNodeBase* tail = &chain;
+        try
+        {
+            for (TListNodeBase* p = head.pNext; p != &head; p = p->pNext)
+            {
+                void* mem = fresh->allocate();
+                TNode* n;
+                try
+                {
+                    n = ::new (mem) TNode(std::move_if_noexcept(static_cast<TNode*>(p)->val));
+                }
+                catch (...)
+                {
+                    fresh->deallocate(mem);
+                    throw;
+                }
+                tail->pNext = n;
+                n->pPrev = tail;
+                tail = n;
+            }
+        }
+        catch (...)
+        {
+            while (tail != &chain)
+            {
+                TListNodeBase* prev = tail->pPrev;
+                destroyNode(*fresh, tail);
+                tail = prev;
+            }
+            throw;
+        }
+        TPool& old = nodePool();
+        for (TListNodeBase* p = head.pNext; p != &head;)
+        {
+            TListNodeBase* next = p->pNext;
+            destroyNode(old, p);
+            p = next;
+        }
+        head.pNext = chain.pNext;
+        head.pNext->pPrev = &head;
+        head.pPrev = tail;
+        tail->pNext = &head;
+        pPool = std::move(fresh);
+    }
+
+    // Устойчивая сортировка слиянием без вспомогательных массивов:
+    // элементы не копируются и не перемещаются, итераторы остаются
+    // действительными. Время O(n log n), доп. память O(1).
+    // Компаратор не должен бросать исключений.
+    template <class Compare>
+    void sort(Compare comp)
+    {
+        if (sz < 2)
+            return;
+        head.pPrev->pNext = nullptr;
+        relinkChain(sortChain(head.pNext, comp));
+    }
+
+    void sort()
+    {
+        sort(std::less<T>());
+    }
+
+    // Меньше стольких узлов на поток parallel_sort сортирует последовательно
+    static constexpr size_t ParallelSortGrain = 1 << 14;
+
+    // Многопоточная сортировка: список режется на куски по числу потоков,
+    // каждый кусок сортируется перевешиванием узлов в своём потоке, затем
+    // соседние серии попарно сливаются (тоже параллельно). Результат
+    // совпадает с sort(comp). Каждый поток работает с копией comp; как и
+    // в sort, компаратор не должен бросать исключений.
+    template <class Compare>
+    void parallel_sort(Compare comp, unsigned threads = 0)
+    {
+        if (!threads)
+            threads = std::thread::hardware_concurrency();
+        size_t chunks = std::min<size_t>(threads, sz / ParallelSortGrain);
+        if (chunks < 2)
+        {
+            sort(comp);
+            return;
+        }
+        head.pPrev->pNext = nullptr;
+        std::vector<TListNodeBase*> runs(chunks);
+        TListNodeBase* p = head.pNext;
+        for (size_t i = 0; i < chunks; i++)
+        {
+            runs[i] = p;
+            size_t len = sz / chunks + (i < sz % chunks ? 1 : 0);
+            for (size_t j = 1; j < len; j++)
+                p = p->pNext;
+            TListNodeBase* next = p->pNext;
+            p->pNext = nullptr;
+            p = next;
+        }
+        runParallel(runs.size(), [&runs, comp](size_t i) {
+            Compare c = comp;
+            runs[i] = sortChain(runs[i], c);
+        });
+        while (runs.size() > 1)
+        {
+            size_t pairs = runs.size() / 2;
+            runParallel(pairs, [&runs, comp](size_t i) {
+                Compare c = comp;
+                runs[2 * i] = mergeChains(runs[2 * i], runs[2 * i + 1], c);
+            });
+            for (size_t i = 0; i < pairs; i++)
+                runs[i] = runs[2 * i];
+            if (runs.size() % 2)
+                runs[pairs++] = runs.back();
+            runs.resize(pairs);
+        }
+        relinkChain(runs[0]);
+    }
+
+    void parallel_sort()
+    {
+        parallel_sort(std::less<T>());
+    }
+
+    // Переносит [first, last) из other перед pos, n - длина диапазона.
+    // Только перевешивает указатели, O(1). pos не должен лежать в [first, last).
+    void splice(const_iterator pos, TList& other, const_iterator first, const_iterator last, size_t n)
+    {
+        if (first == last)
+            return;
+        if (&other != this)
+            sharePool(other);
+        TListNodeBase* p = const_cast<TListNodeBase*>(pos.pNode);
+        TListNodeBase* f = const_cast<TListNodeBase*>(first.pNode);
+        TListNodeBase* l = const_cast<TListNodeBase*>(last.pNode)->pPrev;
+        f->pPrev->pNext = l->pNext;
+        l->pNext->pPrev = f->pPrev;
+        f->pPrev = p->pPrev;
+        l->pNext = p;
+        p->pPrev->pNext = f;
+        p->pPrev = l;
+        other.sz -= n;
+        sz += n;
+    }
+
+    // То же без известной длины: для чужого списка длина считается проходом
+    void splice(const_iterator pos, TList& other, const_iterator first, const_iterator last)
+    {
+        size_t n = &other == this ? 0 : count(first.pNode, last.pNode);
+        splice(pos, other, first, last, n);
+    }
+
+    void splice(const_iterator pos, TList& other, const_iterator it)
+    {
+        if (pos == it)
+            return;
+        const_iterator next = it;
+        splice(pos, other, it, ++next, 1);
+    }
+
+    void splice(const_iterator pos, TList& other)
+    {
+        if (&other != this)
+            splice(pos, other, other.begin(), other.end(), other.sz);
+    }
+
+    void splice(const_iterator pos, TList&& other)
+    {
+        splice(pos, other);
+    }
+
+    // Переносит весь other в конец списка за O(1)
+    void concat(TList&& other)
+    {
+        splice(end(), other);
+    }
+
+    // Отрезает [pos, end()) в отдельный список. Узлы не копируются;
+    // длина считается встречным проходом, O(min(k, size() - k)).
+    TList split_at(const_iterator pos)
+    {
+        const TListNodeBase* fwd = pos.pNode;
+        const TListNodeBase* bwd = pos.pNode;
+        size_t n = 0;
+        while (fwd != &head && bwd != head.pNext)
+        {
+            fwd = fwd->pNext;
+            bwd = bwd->pPrev;
+            n++;
+        }
+        if (fwd != &head)
+            n = sz - n;
+        TList part(res);
+        if (n)
+        {
+            part.pPool = pPool;
+            part.splice(part.end(), *this, pos, end(), n);
+        }
+        return part;
+    }
+
+    void reserve(size_t n)
+    {
+        if (n > sz)
+            nodePool().reserve(n - sz);
+    }
+
+    iterator find(const T& val)
+    {
+        for (iterator it = begin(); it != end(); ++it)
+            if (*it == val)
+                return it;
+        return end();
+    }
+
+    const_iterator find(const T& val) const
+    {
+        for (const_iterator it = begin(); it != end(); ++it)
+            if (*it == val)
+                return it;
+        return end();
+    }
+
+    friend bool operator==(const TList& a, const TList& b)
+    {
+        if (a.sz != b.sz)
+            return false;
+        for (const_iterator i = a.begin(), j = b.begin(); i != a.end(); ++i, ++j)
+            if (!(*i == *j))
+                return false;
+        return true;
+    }
+
+    friend bool operator!=(const TList& a, const TList& b)
+    {
+        return !(a == b);
+    }
+};
+
+template <class T>
+void swap(TList<T>& a, TList<T>& b) noexcept
+{
+    a.swap(b);
+}
+
+// Ёмкость узла TUnrolledList подбирается так, чтобы узел занимал
+// несколько строк кэша целиком
+constexpr size_t CacheLineSize = 64;
+
+struct TUnrolledNodeBase : TListNodeBase
+{
+    size_t cnt;
+};
+
+template <class T, size_t K>
+struct TUnrolledNode : TUnrolledNodeBase
+{
+    alignas(T) unsigned char data[K * sizeof(T)];
+
+    T* at(size_t i)
+    {
+        return std::launder(reinterpret_cast<T*>(data + i * sizeof(T)));
+    }
+
+    const T* at(size_t i) const
+    {
+        return std::launder(reinterpret_cast<const T*>(data + i * sizeof(T)));
+    }
+};
+
+template <class T>
+constexpr size_t unrolledCapacity()
+{
+    size_t k = (4 * CacheLineSize - sizeof(TUnrolledNodeBase)) / sizeof(T);
+    return k < 4 ? 4 : k;
+}
+
+template <class T, size_t K> class TUnrolledList;
+
+template <class T, size_t K, bool Const>
+class TUnrolledIterator
+{
+    template <class, size_t> friend class TUnrolledList;
+    template <class, size_t, bool> friend class TUnrolledIterator;
+
+    using TNode = TUnrolledNode<T, K>;
+    using TBase = std::conditional_t<Const, const TUnrolledNodeBase, TUnrolledNodeBase>;
+
+    TBase* pNode = nullptr;
+    size_t idx = 0;
+
+    TUnrolledIterator(TBase* p, size_t i) : pNode(p), idx(i)
+    {
+    }
+
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    TUnrolledIterator() = default;
+
+    template <bool C = Const, class = std::enable_if_t<C>>
+    TUnrolledIterator(const TUnrolledIterator<T, K, false>& it) : pNode(it.pNode), idx(it.idx)
+    {
+    }
+
+    reference operator*() const
+    {
+        return *static_cast<std::conditional_t<Const, const TNode*, TNode*>>(pNode)->at(idx);
+    }
+
+    pointer operator->() const
+    {
+        return &**this;
+    }
+
+    TUnrolledIterator& operator++()
+    {
+        if (++idx >= pNode->cnt)
+        {
+            pNode = static_cast<TBase*>(pNode->pNext);
+            idx = 0;
+        }
+        return *this;
+    }
+
+    TUnrolledIterator operator++(int)
+    {
+        TUnrolledIterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    TUnrolledIterator& operator--()
+    {
+        if (idx)
+            idx--;
+        else
+        {
+            pNode = static_cast<TBase*>(pNode->pPrev);
+            idx = pNode->cnt - 1;
+        }
+        return *this;
+    }
+
+    TUnrolledIterator operator--(int)
+    {
+        TUnrolledIterator tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    friend bool operator==(const TUnrolledIterator& a, const TUnrolledIterator& b)
+    {
+        return a.pNode == b.pNode && a.idx == b.idx;
+    }
+
+    friend bool operator!=(const TUnrolledIterator& a, const TUnrolledIterator& b)
+    {
+        return !(a == b);
+    }
+};
+
+// Развёрнутый список: каждый узел хранит до K элементов подряд, поэтому
+// полный обход даёт примерно в K раз меньше промахов кэша, чем TList.
+// Интерфейс совпадает с TList. В отличие от TList, вставка и удаление
+// делают недействительными итераторы на элементы того же узла (и соседнего
+// при расщеплении или слиянии узлов).
+template <class T, size_t K = unrolledCapacity<T>()>
+class TUnrolledList
+{
+    static_assert(K >= 2, "TUnrolledList: node capacity must be at least 2");
+
+    using TNode = TUnrolledNode<T, K>;
+
+    TUnrolledNodeBase head;
+    size_t sz = 0;
+    TNodePool<TNode> pool;
+
+    static TNode* node(TListNodeBase* p)
+    {
+        return static_cast<TNode*>(p);
+    }
+
+    TNode* createNode(TListNodeBase* pos)
+    {
+        TNode* n = ::new (pool.allocate()) TNode;
+        n->cnt = 0;
+        n->pNext = pos;
+        n->pPrev = pos->pPrev;
+        pos->pPrev->pNext = n;
+        pos->pPrev = n;
+        return n;
+    }
+
+    void destroyNode(TNode* n) noexcept
+    {
+        n->pPrev->pNext = n->pNext;
+        n->pNext->pPrev = n->pPrev;
+        for (size_t i = 0; i < n->cnt; i++)
+            n->at(i)->~T();
+        pool.deallocate(n);
+    }
+
+    // Перемещает элементы [from, n->cnt) узла n в начало пустого узла m
+    static void moveTail(TNode* n, size_t from, TNode* m) noexcept
+    {
+        for (size_t i = from; i < n->cnt; i++)
+        {
+            ::new (m->at(m->cnt++)) T(std::move(*n->at(i)));
+            n->at(i)->~T();
+        }
+        n->cnt = from;
+    }
+
+    // Сдвигает элементы [i, cnt) на одну позицию вправо, освобождая место i
+    static void openGap(TNode* n, size_t i) noexcept
+    {
+        for (size_t j = n->cnt; j > i; j--)
+        {
+            ::new (n->at(j)) T(std::move(*n->at(j - 1)));
+            n->at(j - 1)->~T();
+        }
+        n->cnt++;
+    }
+
+    void resetHead() noexcept
+    {
+        head.pPrev = head.pNext = &head;
+        head.cnt = 0;
+        sz = 0;
+    }
+
+    void steal(TUnrolledList& other) noexcept
+    {
+        if (other.sz)
+        {
+            head.pNext = other.head.pNext;
+            head.pPrev = other.head.pPrev;
+            head.pNext->pPrev = &head;
+            head.pPrev->pNext = &head;
+            head.cnt = 0;
+            sz = other.sz;
+        }
+        else
+            resetHead();
+        pool = std::move(other.pool);
+        other.resetHead();
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = TUnrolledIterator<T, K, false>;
+    using const_iterator = TUnrolledIterator<T, K, true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_t NodeCapacity = K;
+
+    TUnrolledList()
+    {
+        resetHead();
+    }
+
+    explicit TUnrolledList(size_t n, const T& val = T())
+    {
+        resetHead();
+        for (size_t i = 0; i < n; i++)
+            push_back(val);
+    }
+
+    TUnrolledList(std::initializer_list<T> il)
+    {
+        resetHead();
+        for (const T& v : il)
+            push_back(v);
+    }
+
+    TUnrolledList(const TUnrolledList& other)
+    {
+        resetHead();
+        for (const T& v : other)
+            push_back(v);
+    }
+
+    TUnrolledList(TUnrolledList&& other) noexcept
+    {
+        steal(other);
+    }
+
+    ~TUnrolledList()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            clear();
+    }
+
+    TUnrolledList& operator=(const TUnrolledList& other)
+    {
+        if (this != &other)
+        {
+            TUnrolledList tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    TUnrolledList& operator=(TUnrolledList&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            steal(other);
+        }
+        return *this;
+    }
+
+    void swap(TUnrolledList& other) noexcept
+    {
+        TUnrolledList tmp(std::move(other));
+        other.steal(*this);
+        steal(tmp);
+    }
+
+    iterator begin() noexcept { return iterator(static_cast<TUnrolledNodeBase*>(head.pNext), 0); }
+    iterator end() noexcept { return iterator(&head, 0); }
+    const_iterator begin() const noexcept { return const_iterator(static_cast<const TUnrolledNodeBase*>(head.pNext), 0); }
+    const_iterator end() const noexcept { return const_iterator(&head, 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    bool empty() const noexcept { return sz == 0; }
+    size_t size() const noexcept { return sz; }
+
+    T& front()
+    {
+        if (!sz)
+            throw std::out_of_range("TUnrolledList is empty");
+        return *begin();
+    }
+
+    const T& front() const
+    {
+        if (!sz)
+            throw std::out_of_range("TUnrolledList is empty");
+        return *begin();
+    }
+
+    T& back()
+    {
+        if (!sz)
+            throw std::out_of_range("TUnrolledList is empty");
+        return *--end();
+    }
+
+    const T& back() const
+    {
+        if (!sz)
+            throw std::out_of_range("TUnrolledList is empty");
+        return *--end();
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args)
+    {
+        T val(std::forward<Args>(args)...);
+        TListNodeBase* p = const_cast<TUnrolledNodeBase*>(pos.pNode);
+        size_t i = pos.idx;
+        TNode* n;
+        if (p == &head)
+        {
+            // вставка в конец: дописываем в последний узел, если есть место
+            if (head.pPrev != &head && node(head.pPrev)->cnt < K)
+                n = node(head.pPrev);
+            else
+                n = createNode(&head);
+            i = n->cnt;
+        }
+        else
+        {
+            n = node(p);
+            if (i == 0 && n->pPrev != &head && node(n->pPrev)->cnt < K)
+            {
+                n = node(n->pPrev);
+                i = n->cnt;
+            }
+            else if (n->cnt == K)
+            {
+                // узел полон: вторая половина уходит в новый узел
+                TNode* m = createNode(n->pNext);
+                moveTail(n, K / 2, m);
+                if (i > K / 2)
+                {
+                    n = m;
+                    i -= K / 2;
+                }
+            }
+        }
+        openGap(n, i);
+        ::new (n->at(i)) T(std::move(val));
+        sz++;
+        return iterator(n, i);
+    }
+
+    iterator insert(const_iterator pos, const T& val) { return emplace(pos, val); }
+    iterator insert(const_iterator pos, T&& val) { return emplace(pos, std::move(val)); }
+
+    template <class... Args>
+    T& emplace_front(Args&&... args) { return *emplace(begin(), std::forward<Args>(args)...); }
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) { return *emplace(end(), std::forward<Args>(args)...); }
+
+    void push_front(const T& val) { emplace(begin(), val); }
+    void push_front(T&& val) { emplace(begin(), std::move(val)); }
+    void push_back(const T& val) { emplace(end(), val); }
+    void push_back(T&& val) { emplace(end(), std::move(val)); }
+
+    iterator erase(const_iterator pos)
+    {
+        TListNodeBase* p = const_cast<TUnrolledNodeBase*>(pos.pNode);
+        if (p == &head)
+            throw std::out_of_range("TUnrolledList: erase(end())");
+        TNode* n = node(p);
+        size_t i = pos.idx;
+        n->at(i)->~T();
+        for (size_t j = i + 1; j < n->cnt; j++)
+        {
+            ::new (n->at(j - 1)) T(std::move(*n->at(j)));
+            n->at(j)->~T();
+        }
+        n->cnt--;
+        sz--;
+        TListNodeBase* next = n->pNext;
+        if (n->cnt == 0)
+        {
+            destroyNode(n);
+            return iterator(static_cast<TUnrolledNodeBase*>(next), 0);
+        }
+        // недозаполненный узел поглощает следующий, чтобы плотность не падала
+        if (n->cnt < K / 4 && next != &head && n->cnt + node(next)->cnt <= K)
+        {
+            TNode* m = node(next);
+            for (size_t j = 0; j < m->cnt; j++)
+            {
+                ::new (n->at(n->cnt++)) T(std::move(*m->at(j)));
+                m->at(j)->~T();
+            }
+            m->cnt = 0;
+            destroyNode(m);
+        }
+        if (i == n->cnt)
+            return iterator(static_cast<TUnrolledNodeBase*>(n->pNext), 0);
+        return iterator(n, i);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        // слияние узлов может сдвинуть last, поэтому удаляем по счётчику
+        size_t n = static_cast<size_t>(std::distance(first, last));
+        iterator it(const_cast<TUnrolledNodeBase*>(first.pNode), first.idx);
+        while (n--)
+            it = erase(it);
+        return it;
+    }
+
+    void pop_front()
+    {
+        if (!sz)
+            throw std::out_of_range("TUnrolledList is empty");
+        erase(begin());
+    }
+
+    void pop_back()
+    {
+        if (!sz)
+            throw std::out_of_range("TUnrolledList is empty");
+        erase(--end());
+    }
+
+    void clear() noexcept
+    {
+        while (head.pNext != &head)
+            destroyNode(node(head.pNext));
+        resetHead();
+    }
+
+    iterator find(const T& val)
+    {
+        for (iterator it = begin(); it != end(); ++it)
+            if (*it == val)
+                return it;
+        return end();
+    }
+
+    const_iterator find(const T& val) const
+    {
+        for (const_iterator it = begin(); it != end(); ++it)
+            if (*it == val)
+                return it;
+        return end();
+    }
+
+    friend bool operator==(const TUnrolledList& a, const TUnrolledList& b)
+    {
+        if (a.sz != b.sz)
+            return false;
+        for (const_iterator i = a.begin(), j = b.begin(); i != a.end(); ++i, ++j)
+            if (!(*i == *j))
+                return false;
+        return true;
+    }
+
+    friend bool operator!=(const TUnrolledList& a, const TUnrolledList& b)
+    {
+        return !(a == b);
+    }
+};
+
+template <class T, size_t K>
+void swap(TUnrolledList<T, K>& a, TUnrolledList<T, K>& b) noexcept
+{
+    a.swap(b);
+}
@@ -0,0 +1,333 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include "TList.h"
+
+// Двоичный формат TList для тривиально копируемых T:
+// заголовок TListFileHeader, затем count элементов подряд по elemSize байт
+// в порядке байтов машины, записавшей файл.
+struct TListFileHeader
+{
+    char magic[4];          // "TLST"
+    uint32_t version;
+    uint32_t byteOrder;     // ByteOrderMark в порядке байтов писателя
+    uint32_t elemSize;
+    uint64_t count;
+
+    static constexpr uint32_t CurrentVersion = 1;
+    static constexpr uint32_t ByteOrderMark = 0x01020304;
+};
+
+// Размер буфера, через который идёт полезная нагрузка
+constexpr size_t ListIOChunk = 1 << 16;
+
+template <class T>
+constexpr size_t chunkElements()
+{
+    return ListIOChunk / sizeof(T) ? ListIOChunk / sizeof(T) : 1;
+}
+
+template <class T>
+void save_binary(std::ostream& os, const TList<T>& l)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "save_binary requires a trivially copyable T");
+    TListFileHeader h = {{'T', 'L', 'S', 'T'}, TListFileHeader::CurrentVersion, TListFileHeader::ByteOrderMark,
+                         uint32_t(sizeof(T)), uint64_t(l.size())};
+    os.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    std::vector<T> buf;
+    buf.reserve(chunkElements<T>());
+    for (const T& v : l)
+    {
+        buf.push_back(v);
+        if (buf.size() == buf.capacity())
+        {
+            os.write(reinterpret_cast<const char*>(buf.data()), std::streamsize(buf.size() * sizeof(T)));
+            buf.clear();
+        }
+    }
+    os.write(reinterpret_cast<const char*>(buf.data()), std::streamsize(buf.size() * sizeof(T)));
+    if (!os)
+        throw std::runtime_error("save_binary: write failed");
+}
+
+// Остаток потока в байтах или -1, если поток не позиционируется
+inline std::streamoff stream_remaining(std::istream& is)
+{
+    std::streampos pos = is.tellg();
+    if (pos == std::streampos(-1) || !is.seekg(0, std::ios::end))
+    {
+        is.clear();
+        return -1;
+    }
+    std::streamoff n = is.tellg() - pos;
+    is.seekg(pos);
+    return n;
+}
+
+// Читает и проверяет заголовок; поток остаётся на начале данных
+template <class T>
+TListFileHeader read_binary_header(std::istream& is)
+{
+    TListFileHeader h;
+    if (!is.read(reinterpret_cast<char*>(&h), sizeof(h)))
+        throw std::runtime_error("load_binary: truncated header");
+    if (std::memcmp(h.magic, "TLST", 4) != 0)
+        throw std::runtime_error("load_binary: not a TList file");
+    if (h.version != TListFileHeader::CurrentVersion)
+        throw std::runtime_error("load_binary: unsupported version");
+    if (h.byteOrder != TListFileHeader::ByteOrderMark)
+        throw std::runtime_error("load_binary: file has a different byte order");
+    if (h.elemSize != sizeof(T))
+        throw std::runtime_error("load_binary: element size mismatch");
+    return h;
+}
+
+// Заменяет содержимое l данными из потока. Если размер потока известен и
+// вмещает count элементов, все узлы резервируются заранее одним вызовом
+// reserve; иначе счётчику из файла не доверяем и резервируем по блоку по
+// мере чтения. Данные читаются блоками прямо в буфер элементов и копируются
+// в узлы без разбора. При ошибке l не меняется.
+template <class T>
+void load_binary(std::istream& is, TList<T>& l)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "load_binary requires a trivially copyable T");
+    TListFileHeader h = read_binary_header<T>(is);
+
+    // заведомо битый счётчик не должен приводить к огромному резерву
+    std::streamoff avail = stream_remaining(is);
+    if (avail >= 0 && uint64_t(avail) / sizeof(T) < h.count)
+        throw std::runtime_error("load_binary: truncated payload");
+
+    TList<T> res(l.resource());
+    if (avail >= 0)
+        res.reserve(size_t(h.count));
+    std::vector<T> buf(size_t(std::min<uint64_t>(h.count, chunkElements<T>())));
+    uint64_t left = h.count;
+    while (left)
+    {
+        size_t n = size_t(std::min<uint64_t>(left, buf.size()));
+        if (!is.read(reinterpret_cast<char*>(buf.data()), std::streamsize(n * sizeof(T))))
+            throw std::runtime_error("load_binary: truncated payload");
+        res.reserve(res.size() + n);
+        for (size_t i = 0; i < n; i++)
+            res.push_back(buf[i]);
+        left -= n;
+    }
+    l = std::move(res);
+}
+
+template <class T>
+void save_binary(const std::string& path, const TList<T>& l)
+{
+    std::ofstream os(path, std::ios::binary);
+    if (!os)
+        throw std::runtime_error("save_binary: cannot open " + path);
+    save_binary(os, l);
+}
+
+template <class T>
+void load_binary(const std::string& path, TList<T>& l)
+{
+    std::ifstream is(path, std::ios::binary);
+    if (!is)
+        throw std::runtime_error("load_binary: cannot open " + path);
+    load_binary(is, l);
+}
+
+// Чтение потока блоками по ListIOChunk байт с разбиением на слова,
+// разделённые пробельными символами. Берёт данные прямо из streambuf,
+// минуя форматированный ввод.
+class TTokenReader
+{
+    std::istream& is;
+    std::vector<char> buf;
+    size_t pos = 0;
+    size_t end = 0;
+    bool eof = false;
+    uint64_t nread = 0;
+
+    // Переносит непрочитанный хвост в начало буфера и дочитывает блок
+    bool refill();
+
+public:
+    // chunk = 0 считается за 1
+    explicit TTokenReader(std::istream& s, size_t chunk = ListIOChunk);
+
+    // Следующее слово; пустое - конец потока. Действительно до следующего вызова.
+    std::string_view next();
+
+    // Сколько байт уже взято из потока
+    uint64_t bytes_read() const noexcept { return nread; }
+};
+
+// Запись в поток через буфер в ListIOChunk байт; остаток буфера
+// записывается только явным flush()
+class TTokenWriter
+{
+    std::ostream& os;
+    std::vector<char> buf;
+    size_t used = 0;
+
+public:
+    explicit TTokenWriter(std::ostream& s, size_t chunk = ListIOChunk);
+    TTokenWriter(const TTokenWriter&) = delete;
+    TTokenWriter& operator=(const TTokenWriter&) = delete;
+
+    // Место под n байт в конце буфера; заполненное подтверждается commit
+    char* reserve(size_t n);
+    void commit(char* end) { used = size_t(end - buf.data()); }
+    void flush();
+};
+
+// Числа, для которых есть to_chars/from_chars
+template <class T>
+constexpr bool isTextNumber = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+// Наибольшая длина числа в тексте, включая кратчайшую запись double
+constexpr size_t MaxNumberChars = 64;
+
+// Разбирает слово целиком; false, если это не число типа T
+template <class T>
+bool parse_number(std::string_view tok, T& val)
+{
+    std::from_chars_result r = std::from_chars(tok.data(), tok.data() + tok.size(), val);
+    return r.ec == std::errc() && r.ptr == tok.data() + tok.size();
+}
+
+// Пишет элементы через пробел кратчайшей точной записью
+template <class T, class = std::enable_if_t<isTextNumber<T>>>
+std::ostream& operator<<(std::ostream& os, const TList<T>& l)
+{
+    TTokenWriter w(os);
+    bool first = true;
+    for (const T& v : l)
+    {
+        char* p = w.reserve(MaxNumberChars + 1);
+        if (!first)
+            *p++ = ' ';
+        first = false;
+        w.commit(std::to_chars(p, p + MaxNumberChars, v).ptr);
+    }
+    w.flush();
+    return os;
+}
+
+// Читает числа, разделённые пробельными символами, до конца потока и
+// заменяет ими содержимое l; в отличие от чтения одного числа, поток
+// всегда потребляется до конца. Поток с уже выставленной ошибкой не
+// читается. Если встретилось не число, выставляется failbit и l не
+// меняется; поток читается блоками, поэтому часть данных за плохим словом
+// к этому моменту уже взята из него и потеряна.
+template <class T, class = std::enable_if_t<isTextNumber<T>>>
+std::istream& operator>>(std::istream& is, TList<T>& l)
+{
+    // пробелы пропускает сам TTokenReader
+    std::istream::sentry ok(is, true);
+    if (!ok)
+        return is;
+    TList<T> res(l.resource());
+    TTokenReader r(is);
+    for (std::string_view tok = r.next(); !tok.empty(); tok = r.next())
+    {
+        T v;
+        if (!parse_number(tok, v))
+        {
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+        res.push_back(v);
+    }
+    is.setstate(std::ios::eofbit);
+    l = std::move(res);
+    return is;
+}
+
+// Потоковая загрузка: файл читается блоками по chunk байт, и разобранные
+// элементы сразу дописываются в конец списка. Кроме самого списка в памяти
+// только один блок, поэтому можно загружать файлы больше половины ОЗУ.
+// progress(прочитано байт, всего байт) вызывается после каждого блока;
+// всего - 0, если размер потока неизвестен. При ошибке бросается
+// runtime_error, а уже дописанные элементы остаются в списке.
+using TLoadProgress = std::function<void(uint64_t done, uint64_t total)>;
+
+// Дописывает числа из текста; возвращает число добавленных элементов
+template <class T, class = std::enable_if_t<isTextNumber<T>>>
+size_t append_text(std::istream& is, TList<T>& l, const TLoadProgress& progress = TLoadProgress(), size_t chunk = ListIOChunk)
+{
+    uint64_t total = progress ? uint64_t(std::max<std::streamoff>(stream_remaining(is), 0)) : 0;
+    TTokenReader r(is, chunk);
+    uint64_t reported = 0;
+    size_t added = 0;
+    for (std::string_view tok = r.next(); !tok.empty(); tok = r.next())
+    {
+        T v;
+        if (!parse_number(tok, v))
+            throw std::runtime_error("append_text: not a number: " + std::string(tok));
+        l.push_back(v);
+        added++;
+        if (progress && r.bytes_read() != reported)
+        {
+            reported = r.bytes_read();
+            progress(reported, total);
+        }
+    }
+    if (progress && r.bytes_read() != reported)
+        progress(r.bytes_read(), total);
+    return added;
+}
+
+// Дописывает элементы из двоичного формата save_binary
+template <class T>
+size_t append_binary(std::istream& is, TList<T>& l, const TLoadProgress& progress = TLoadProgress(), size_t chunk = ListIOChunk)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "append_binary requires a trivially copyable T");
+    uint64_t total = progress ? uint64_t(std::max<std::streamoff>(stream_remaining(is), 0)) : 0;
+    TListFileHeader h = read_binary_header<T>(is);
+    uint64_t done = sizeof(h);
+    std::vector<T> buf(size_t(std::min<uint64_t>(h.count, std::max<size_t>(chunk / sizeof(T), 1))));
+    uint64_t left = h.count;
+    while (left)
+    {
+        size_t n = size_t(std::min<uint64_t>(left, buf.size()));
+        if (!is.read(reinterpret_cast<char*>(buf.data()), std::streamsize(n * sizeof(T))))
+            throw std::runtime_error("append_binary: truncated payload");
+        l.reserve(l.size() + n);
+        for (size_t i = 0; i < n; i++)
+            l.push_back(buf[i]);
+        left -= n;
+        done += n * sizeof(T);
+        if (progress)
+            progress(done, total);
+    }
+    return size_t(h.count);
+}
+
+template <class T, class = std::enable_if_t<isTextNumber<T>>>
+size_t append_text(const std::string& path, TList<T>& l, const TLoadProgress& progress = TLoadProgress(), size_t chunk = ListIOChunk)
+{
+    std::ifstream is(path, std::ios::binary);
+    if (!is)
+        throw std::runtime_error("append_text: cannot open " + path);
+    return append_text(is, l, progress, chunk);
+}
+
+template <class T>
+size_t append_binary(const std::string& path, TList<T>& l, const TLoadProgress& progress = TLoadProgress(), size_t chunk = ListIOChunk)
+{
+    std::ifstream is(path, std::ios::binary);
+    if (!is)
+        throw std::runtime_error("append_binary: cannot open " + path);
+    return append_binary(is, l, progress, chunk);
+}
@@ -0,0 +1,362 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Файл, целиком отображённый в память (MAP_SHARED). При росте отображение
+// может переехать, поэтому указатели внутрь него хранить нельзя.
+class TMappedFile
+{
+    int fd = -1;
+    char* pBase = nullptr;
+    size_t len = 0;
+    bool created = false;
+
+public:
+    // Открывает файл или создаёт новый размером minSize байт
+    TMappedFile(const std::string& path, size_t minSize);
+    TMappedFile(const TMappedFile&) = delete;
+    TMappedFile& operator=(const TMappedFile&) = delete;
+    ~TMappedFile();
+
+    char* data() const noexcept { return pBase; }
+    size_t size() const noexcept { return len; }
+    bool isNew() const noexcept { return created; }
+
+    // Увеличивает файл и отображение до n байт
+    void grow(size_t n);
+
+    // Сбрасывает изменённые страницы на диск
+    void sync();
+};
+
+// Связь узла в файле: смещения от начала файла, 0 - нет узла
+struct TMappedLink
+{
+    uint64_t prev;
+    uint64_t next;
+};
+
+// Заголовок файла списка. head - фиктивный узел кольца.
+struct TMappedHeader
+{
+    char magic[4];          // "TLMP"
+    uint32_t version;
+    uint32_t elemSize;
+    uint32_t nodeSize;
+    uint64_t count;
+    uint64_t used;          // конец занятой части файла
+    uint64_t freeList;      // односвязный список свободных узлов (через next)
+    TMappedLink head;
+
+    static constexpr uint32_t CurrentVersion = 1;
+};
+
+template <class T> class TMappedList;
+
+template <class T, bool Const>
+class TMappedIterator
+{
+    template <class U> friend class TMappedList;
+    template <class U, bool> friend class TMappedIterator;
+
+    using TOwner = std::conditional_t<Const, const TMappedList<T>, TMappedList<T>>;
+
+    TOwner* pList = nullptr;
+    uint64_t off = 0;
+
+    TMappedIterator(TOwner* l, uint64_t o) : pList(l), off(o)
+    {
+    }
+
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    TMappedIterator() = default;
+
+    template <bool C = Const, class = std::enable_if_t<C>>
+    TMappedIterator(const TMappedIterator<T, false>& it) : pList(it.pList), off(it.off)
+    {
+    }
+
+    reference operator*() const { return pList->node(off)->val; }
+    pointer operator->() const { return &pList->node(off)->val; }
+
+    TMappedIterator& operator++()
+    {
+        off = pList->node(off)->link.next;
+        return *this;
+    }
+
+    TMappedIterator operator++(int)
+    {
+        TMappedIterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    TMappedIterator& operator--()
+    {
+        off = pList->node(off)->link.prev;
+        return *this;
+    }
+
+    TMappedIterator operator--(int)
+    {
+        TMappedIterator tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    friend bool operator==(const TMappedIterator& a, const TMappedIterator& b) { return a.off == b.off; }
+    friend bool operator!=(const TMappedIterator& a, const TMappedIterator& b) { return a.off != b.off; }
+};
+
+// Персистентный двусвязный список, узлы которого живут в отображённом
+// файле и ссылаются друг на друга смещениями, а не указателями. Открытие
+// существующего файла - O(1): проверяется заголовок, и список сразу готов
+// к работе без десериализации; страницы подгружаются ОС по мере обращения
+// и делятся между процессами через страничный кэш. Элементы - только
+// тривиально копируемые типы без указателей в собственную память.
+// Одновременная запись из нескольких процессов не поддерживается.
+// Итераторы хранят смещение и переживают перемещение отображения при росте.
+template <class T>
+class TMappedList
+{
+    static_assert(std::is_trivially_copyable_v<T>, "TMappedList requires a trivially copyable T");
+
+    template <class U, bool> friend class TMappedIterator;
+
+    struct TNode
+    {
+        TMappedLink link;
+        T val;
+    };
+
+    static constexpr uint64_t HeadOffset = offsetof(TMappedHeader, head);
+    static constexpr size_t NodeAlign = alignof(TNode) > alignof(TMappedHeader) ? alignof(TNode) : alignof(TMappedHeader);
+    static constexpr uint64_t FirstNode = (sizeof(TMappedHeader) + NodeAlign - 1) / NodeAlign * NodeAlign;
+    static constexpr size_t MinFileSize = 4096;
+
+    TMappedFile file;
+
+    TMappedHeader* header() const noexcept
+    {
+        return reinterpret_cast<TMappedHeader*>(file.data());
+    }
+
+    TMappedLink* link(uint64_t off) const noexcept
+    {
+        return reinterpret_cast<TMappedLink*>(file.data() + off);
+    }
+
+    TNode* node(uint64_t off) const noexcept
+    {
+        return reinterpret_cast<TNode*>(file.data() + off);
+    }
+
+    void init()
+    {
+        TMappedHeader* h = header();
+        h->magic[0] = 'T';
+        h->magic[1] = 'L';
+        h->magic[2] = 'M';
+        h->magic[3] = 'P';
+        h->version = TMappedHeader::CurrentVersion;
+        h->elemSize = sizeof(T);
+        h->nodeSize = sizeof(TNode);
+        h->count = 0;
+        h->used = FirstNode;
+        h->freeList = 0;
+        h->head.prev = h->head.next = HeadOffset;
+    }
+
+    void check() const
+    {
+        const TMappedHeader* h = header();
+        if (file.size() < FirstNode || h->magic[0] != 'T' || h->magic[1] != 'L' || h->magic[2] != 'M' || h->magic[3] != 'P')
+            throw std::runtime_error("TMappedList: not a mapped list file");
+        if (h->version != TMappedHeader::CurrentVersion)
+            throw std::runtime_error("TMappedList: unsupported version");
+        if (h->elemSize != sizeof(T) || h->nodeSize != sizeof(TNode))
+            throw std::runtime_error("TMappedList: element type mismatch");
+        if (h->used > file.size())
+            throw std::runtime_error("TMappedList: file is truncated");
+        if (h->used < FirstNode || (h->used - FirstNode) % sizeof(TNode) != 0)
+            throw std::runtime_error("TMappedList: file is corrupted");
+        if (!isLink(h->head.next) || !isLink(h->head.prev) || (h->freeList && !isNode(h->freeList)))
+            throw std::runtime_error("TMappedList: file is corrupted");
+    }
+
+    // Смещение выданного узла: внутри [FirstNode, used) на границе узла
+    bool isNode(uint64_t off) const noexcept
+    {
+        return off >= FirstNode && off < header()->used && (off - FirstNode) % sizeof(TNode) == 0;
+    }
+
+    bool isLink(uint64_t off) const noexcept
+    {
+        return off == HeadOffset || isNode(off);
+    }
+
+    // Свободный узел; может переместить отображение
+    uint64_t allocate()
+    {
+        TMappedHeader* h = header();
+        if (h->freeList)
+        {
+            uint64_t off = h->freeList;
+            h->freeList = link(off)->next;
+            return off;
+        }
+        if (h->used + sizeof(TNode) > file.size())
+        {
+            file.grow(std::max<size_t>(file.size() * 2, h->used + sizeof(TNode)));
+            h = header();
+        }
+        uint64_t off = h->used;
+        h->used += sizeof(TNode);
+        return off;
+    }
+
+    void deallocate(uint64_t off) noexcept
+    {
+        link(off)->next = header()->freeList;
+        header()->freeList = off;
+    }
+
+    uint64_t linkBefore(uint64_t pos, const T& val)
+    {
+        // val может лежать в самом файле, а allocate() при росте его переотображает
+        T copy = val;
+        uint64_t off = allocate();
+        TNode* n = node(off);
+        n->val = copy;
+        TMappedLink* p = link(pos);
+        n->link.next = pos;
+        n->link.prev = p->prev;
+        link(p->prev)->next = off;
+        p->prev = off;
+        header()->count++;
+        return off;
+    }
+
+    uint64_t unlink(uint64_t off) noexcept
+    {
+        TMappedLink* p = link(off);
+        uint64_t next = p->next;
+        link(p->prev)->next = next;
+        link(next)->prev = p->prev;
+        deallocate(off);
+        header()->count--;
+        return next;
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = TMappedIterator<T, false>;
+    using const_iterator = TMappedIterator<T, true>;
+
+    // Открывает список из файла path или создаёт пустой
+    explicit TMappedList(const std::string& path) : file(path, MinFileSize)
+    {
+        if (file.isNew())
+            init();
+        else
+            check();
+    }
+
+    TMappedList(const TMappedList&) = delete;
+    TMappedList& operator=(const TMappedList&) = delete;
+
+    iterator begin() noexcept { return iterator(this, header()->head.next); }
+    iterator end() noexcept { return iterator(this, HeadOffset); }
+    const_iterator begin() const noexcept { return const_iterator(this, header()->head.next); }
+    const_iterator end() const noexcept { return const_iterator(this, HeadOffset); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool empty() const noexcept { return header()->count == 0; }
+    size_t size() const noexcept { return size_t(header()->count); }
+
+    // Байты файла, занятые заголовком и узлами (включая свободные)
+    size_t bytes_used() const noexcept { return size_t(header()->used); }
+
+    T& front()
+    {
+        if (empty())
+            throw std::out_of_range("TMappedList is empty");
+        return node(header()->head.next)->val;
+    }
+
+    T& back()
+    {
+        if (empty())
+            throw std::out_of_range("TMappedList is empty");
+        return node(header()->head.prev)->val;
+    }
+
+    iterator insert(const_iterator pos, const T& val)
+    {
+        return iterator(this, linkBefore(pos.off, val));
+    }
+
+    void push_front(const T& val) { linkBefore(header()->head.next, val); }
+    void push_back(const T& val) { linkBefore(HeadOffset, val); }
+
+    iterator erase(const_iterator pos)
+    {
+        if (pos.off == HeadOffset)
+            throw std::out_of_range("TMappedList: erase(end())");
+        return iterator(this, unlink(pos.off));
+    }
+
+    void pop_front()
+    {
+        if (empty())
+            throw std::out_of_range("TMappedList is empty");
+        unlink(header()->head.next);
+    }
+
+    void pop_back()
+    {
+        if (empty())
+            throw std::out_of_range("TMappedList is empty");
+        unlink(header()->head.prev);
+    }
+
+    // Освобождает все узлы; файл не уменьшается
+    void clear() noexcept
+    {
+        TMappedHeader* h = header();
+        h->count = 0;
+        h->used = FirstNode;
+        h->freeList = 0;
+        h->head.prev = h->head.next = HeadOffset;
+    }
+
+    iterator find(const T& val)
+    {
+        iterator it = begin();
+        while (it != end() && !(*it == val))
+            ++it;
+        return it;
+    }
+
+    // Сбрасывает изменения на диск (msync); без вызова их сохранит ОС
+    void flush()
+    {
+        file.sync();
+    }
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Выполняет f(0..n-1), каждый вызов в своём потоке (последний - в текущем).
+// Если поток не удалось запустить, оставшиеся вызовы выполняются в текущем.
+// Возврат - только после завершения всех потоков; первое исключение из
+// вызовов f пробрасывается после этого.
+template <class F>
+void runParallel(size_t n, F f)
+{
+    if (n <= 1)
+    {
+        if (n)
+            f(0);
+        return;
+    }
+
+    std::exception_ptr error;
+    std::mutex errorLock;
+    auto call = [&f, &error, &errorLock](size_t i) {
+        try
+        {
+            f(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorLock);
+            if (!error)
+                error = std::current_exception();
+        }
+    };
+
+    {
+        struct TJoinAll
+        {
+            std::vector<std::thread> workers;
+
+            ~TJoinAll()
+            {
+                for (std::thread& w : workers)
+                    w.join();
+            }
+        } pool;
+
+        pool.workers.reserve(n - 1);
+        size_t i = 0;
+        try
+        {
+            for (; i + 1 < n; i++)
+                pool.workers.emplace_back(call, i);
+        }
+        catch (...)
+        {
+        }
+        for (; i < n; i++)
+            call(i);
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
@@ -0,0 +1,177 @@
+#pragma once
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+#include "TList.h"
+
+// Степени Vars переменных, упакованные в одно 64-битное слово: на
+// переменную поле из Width бит и над ним защитный бит (первая переменная -
+// в старших полях). Сравнение ключей совпадает с лексикографическим
+// сравнением степеней, произведение мономов - одно сложение ключей: сумма
+// поля не превосходит 2^(Width+1) - 1 и не переносится в соседнее поле, а
+// переполнение степени оставляет защитный бит, который проверяется одной
+// маской - можно и сразу для многих сумм, объединённых через ИЛИ.
+template <unsigned Vars, unsigned Width>
+struct TPackedExps
+{
+    static_assert(Vars >= 1 && Width >= 1 && Vars * (Width + 1) <= 64, "packed exponents must fit in 64 bits");
+
+    static constexpr unsigned VarCount = Vars;
+    static constexpr unsigned Stride = Width + 1;
+    static constexpr uint64_t MaxExp = (uint64_t(1) << Width) - 1;
+
+    static constexpr unsigned shift(unsigned var) { return (Vars - 1 - var) * Stride; }
+
+    static constexpr uint64_t guardMask()
+    {
+        uint64_t m = 0;
+        for (unsigned v = 0; v < Vars; v++)
+            m |= uint64_t(1) << (shift(v) + Width);
+        return m;
+    }
+
+    static constexpr uint64_t GuardMask = guardMask();
+
+    // Бросает overflow_error, если степень больше MaxExp
+    template <class... E>
+    static uint64_t pack(E... e)
+    {
+        static_assert(sizeof...(E) == Vars, "pack() takes one exponent per variable");
+        const uint64_t exps[] = {uint64_t(e)...};
+        if ((uint64_t(e) | ...) > MaxExp)
+            throw std::overflow_error("TPackedExps: exponent is too large");
+        uint64_t key = 0;
+        for (unsigned v = 0; v < Vars; v++)
+            key |= exps[v] << shift(v);
+        return key;
+    }
+
+    static constexpr uint64_t get(uint64_t key, unsigned var)
+    {
+        return (key >> shift(var)) & MaxExp;
+    }
+
+    // Ключ произведения мономов; проверять overflowed()
+    static constexpr uint64_t mul(uint64_t a, uint64_t b) { return a + b; }
+    static constexpr bool overflowed(uint64_t key) { return (key & GuardMask) != 0; }
+
+    // Поле за полем max(a, b) без ветвлений: защитный бит разности
+    // (a | G) - b показывает, в каких полях a >= b
+    static constexpr uint64_t max(uint64_t a, uint64_t b)
+    {
+        uint64_t ge = ((a | GuardMask) - b) & GuardMask;
+        uint64_t m = ge - (ge >> Width);
+        return (a & m) | (b & ~m & ~GuardMask);
+    }
+};
+
+// Моном coef * x^a * y^b * z^c; степени упакованы в key (TPackedExps)
+struct TMonom
+{
+    using TExps = TPackedExps<3, 16>;
+
+    static constexpr int VarCount = TExps::VarCount;
+    static constexpr unsigned MaxExp = unsigned(TExps::MaxExp);
+
+    double coef;
+    uint64_t key;
+
+    TMonom(double c = 0, uint64_t k = 0) : coef(c), key(k)
+    {
+    }
+
+    TMonom(double c, unsigned x, unsigned y, unsigned z) : coef(c), key(TExps::pack(x, y, z))
+    {
+    }
+
+    // Степень переменной var (0 - x, 1 - y, 2 - z)
+    unsigned exp(int var) const { return unsigned(TExps::get(key, unsigned(var))); }
+
+    bool operator==(const TMonom& m) const { return coef == m.coef && key == m.key; }
+    bool operator!=(const TMonom& m) const { return !(*this == m); }
+};
+
+// Способ умножения многочленов
+enum class TMulMethod
+{
+    Auto,   // по размерам и плотности множителей
+    Heap,   // слияние через кучу: члены выходят упорядоченными, память O(min(n, m))
+    Hash    // накопление в хеш-таблице и сортировка: для плотных произведений
+};
+
+// Разреженный многочлен от x, y, z: список ненулевых мономов, упорядоченный
+// по убыванию ключа. Сложение и вычитание - слияние двух упорядоченных
+// списков за O(n + m) без пересортировки; память пропорциональна числу
+// ненулевых членов.
+class TPolynom
+{
+    using TTermIt = TList<TMonom>::const_iterator;
+
+    TList<TMonom> terms;
+
+    // *this += k * q
+    void addScaled(const TPolynom& q, double k);
+
+    // Ключ из наибольших степеней каждой переменной
+    uint64_t maxExps() const;
+
+    // Проверяет степени произведения и выбирает способ вместо Auto
+    static TMulMethod prepareProduct(const TPolynom& a, const TPolynom& b, TMulMethod method);
+
+    // Произведение членов [first, last) меньшего множителя на b
+    static TPolynom mulRange(TTermIt first, TTermIt last, const TPolynom& b, TMulMethod method);
+    static TPolynom mulHeap(TTermIt first, TTermIt last, const TPolynom& b);
+    static TPolynom mulHash(TTermIt first, TTermIt last, const TPolynom& b);
+
+public:
+    TPolynom() = default;
+
+    // Члены в любом порядке; равные степени складываются, нули отбрасываются
+    TPolynom(std::initializer_list<TMonom> il);
+    explicit TPolynom(TList<TMonom> l);
+
+    const TList<TMonom>& monoms() const noexcept { return terms; }
+    size_t size() const noexcept { return terms.size(); }
+    bool empty() const noexcept { return terms.empty(); }
+
+    // Коэффициент при x^a y^b z^c
+    double coef(unsigned x, unsigned y, unsigned z) const;
+
+    TPolynom& operator+=(const TPolynom& q);
+    TPolynom& operator+=(TPolynom&& q);
+    TPolynom& operator-=(const TPolynom& q);
+    TPolynom& operator*=(const TPolynom& q);
+    TPolynom& operator*=(double k);
+
+    TPolynom operator+(const TPolynom& q) const;
+    TPolynom operator-(const TPolynom& q) const;
+    TPolynom operator*(const TPolynom& q) const;
+    TPolynom operator*(double k) const;
+    TPolynom operator-() const;
+
+    double operator()(double x, double y, double z) const;
+
+    // Значения в n точках (x[i], y[i], z[i]) записываются в out[i]. Список
+    // обходится один раз; точки обрабатываются блоками, для блока строятся
+    // таблицы степеней, а члены накапливаются сразу по всем точкам блока.
+    void evaluate(const double* x, const double* y, const double* z, size_t n, double* out) const;
+    std::vector<double> evaluate(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z) const;
+
+    // Произведение выбранным способом; operator* использует Auto
+    static TPolynom multiply(const TPolynom& p, const TPolynom& q, TMulMethod method = TMulMethod::Auto);
+
+    // Auto выбирает Hash, если на один возможный моном произведения
+    // (по габаритам степеней) приходится не меньше HashDensity произведений членов
+    static constexpr double HashDensity = 0.5;
+
+    // Многопоточное произведение; threads = 0 - по числу ядер. Результат
+    // совпадает с multiply(p, q, method) с точностью до порядка сложения.
+    static TPolynom parallel_multiply(const TPolynom& p, const TPolynom& q, unsigned threads = 0, TMulMethod method = TMulMethod::Auto);
+
+    // Меньше стольких произведений членов на поток parallel_multiply не делит работу
+    static constexpr size_t ParallelMulGrain = 1 << 16;
+
+    bool operator==(const TPolynom& q) const { return terms == q.terms; }
+    bool operator!=(const TPolynom& q) const { return !(*this == q); }
+};
@@ -0,0 +1,254 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include "TEpoch.h"
+
+// Список для сценария «много чтений, редкие записи» в духе RCU.
+// Читатели обходят список без блокировок и атомарных RMW: узлы
+// публикуются release-записью указателя, читатель лишь объявляет эпоху
+// (TEpoch::TGuard). Писатели сериализуются мьютексом; исключённые узлы
+// освобождаются через TEpoch после грейс-периода. Элемент никогда не
+// меняется на месте: replace_if публикует новый узел вместо старого.
+template <class T>
+class TRcuList
+{
+    struct TNode
+    {
+        T val;
+        std::atomic<TNode*> pNext{nullptr};
+
+        template <class... Args>
+        explicit TNode(Args&&... args) : val(std::forward<Args>(args)...)
+        {
+        }
+    };
+
+    std::atomic<TNode*> pFirst{nullptr};
+    TNode* pLast = nullptr;                 // только для писателей
+    std::atomic<size_t> sz{0};
+    std::mutex writeMtx;
+
+    static void deleteNode(void* p)
+    {
+        delete static_cast<TNode*>(p);
+    }
+
+    // Ссылка, через которую достижим узел p (под writeMtx)
+    std::atomic<TNode*>& linkTo(TNode* prev)
+    {
+        return prev ? prev->pNext : pFirst;
+    }
+
+    void retire(TNode* prev, TNode* p)
+    {
+        linkTo(prev).store(p->pNext.load(std::memory_order_relaxed), std::memory_order_release);
+        if (pLast == p)
+            pLast = prev;
+        sz.store(sz.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        TEpoch::retire(p, deleteNode);
+    }
+
+public:
+    class const_iterator
+    {
+        friend class TRcuList;
+        const TNode* pNode = nullptr;
+
+        explicit const_iterator(const TNode* p) : pNode(p)
+        {
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        const T& operator*() const { return pNode->val; }
+        const T* operator->() const { return &pNode->val; }
+
+        const_iterator& operator++()
+        {
+            pNode = pNode->pNext.load(std::memory_order_acquire);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.pNode == b.pNode; }
+        friend bool operator!=(const const_iterator& a, const const_iterator& b) { return a.pNode != b.pNode; }
+    };
+
+    // Критическая секция читателя: пока объект жив, видимые через него
+    // узлы не освобождаются. Писать в список из секции можно, но
+    // TEpoch::synchronize() вызывать нельзя.
+    class TReadView
+    {
+        friend class TRcuList;
+        TEpoch::TGuard guard;
+        const TRcuList& list;
+
+        explicit TReadView(const TRcuList& l) : list(l)
+        {
+        }
+
+    public:
+        const_iterator begin() const { return const_iterator(list.pFirst.load(std::memory_order_acquire)); }
+        const_iterator end() const { return const_iterator(); }
+    };
+
+    TRcuList() = default;
+    TRcuList(const TRcuList&) = delete;
+    TRcuList& operator=(const TRcuList&) = delete;
+
+    // Разрушать список можно, только когда его никто не читает
+    ~TRcuList()
+    {
+        TNode* p = pFirst.load(std::memory_order_relaxed);
+        while (p)
+        {
+            TNode* next = p->pNext.load(std::memory_order_relaxed);
+            delete p;
+            p = next;
+        }
+    }
+
+    size_t size() const { return sz.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+
+    // ---- читатели ----
+
+    TReadView read() const
+    {
+        return TReadView(*this);
+    }
+
+    template <class F>
+    void for_each(F f) const
+    {
+        TEpoch::TGuard g;
+        for (const TNode* p = pFirst.load(std::memory_order_acquire); p; p = p->pNext.load(std::memory_order_acquire))
+            f(p->val);
+    }
+
+    // Копия первого элемента, удовлетворяющего pred
+    template <class Pred>
+    std::optional<T> find_if(Pred pred) const
+    {
+        TEpoch::TGuard g;
+        for (const TNode* p = pFirst.load(std::memory_order_acquire); p; p = p->pNext.load(std::memory_order_acquire))
+            if (pred(p->val))
+                return p->val;
+        return std::nullopt;
+    }
+
+    bool contains(const T& val) const
+    {
+        return find_if([&val](const T& v) { return v == val; }).has_value();
+    }
+
+    // ---- писатели ----
+
+    template <class... Args>
+    void emplace_front(Args&&... args)
+    {
+        TNode* n = new TNode(std::forward<Args>(args)...);
+        std::lock_guard<std::mutex> lock(writeMtx);
+        n->pNext.store(pFirst.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        pFirst.store(n, std::memory_order_release);
+        if (!pLast)
+            pLast = n;
+        sz.store(sz.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    template <class... Args>
+    void emplace_back(Args&&... args)
+    {
+        TNode* n = new TNode(std::forward<Args>(args)...);
+        std::lock_guard<std::mutex> lock(writeMtx);
+        linkTo(pLast).store(n, std::memory_order_release);
+        pLast = n;
+        sz.store(sz.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void push_front(const T& val) { emplace_front(val); }
+    void push_back(const T& val) { emplace_back(val); }
+
+    // Заменяет первый элемент, удовлетворяющий pred, новым узлом
+    template <class Pred>
+    bool replace_if(Pred pred, const T& val)
+    {
+        TNode* n = new TNode(val);
+        std::lock_guard<std::mutex> lock(writeMtx);
+        TNode* prev = nullptr;
+        for (TNode* p = pFirst.load(std::memory_order_relaxed); p; prev = p, p = p->pNext.load(std::memory_order_relaxed))
+        {
+            if (pred(p->val))
+            {
+                n->pNext.store(p->pNext.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                linkTo(prev).store(n, std::memory_order_release);
+                if (pLast == p)
+                    pLast = n;
+                TEpoch::retire(p, deleteNode);
+                return true;
+            }
+        }
+        delete n;
+        return false;
+    }
+
+    template <class Pred>
+    size_t erase_if(Pred pred)
+    {
+        std::lock_guard<std::mutex> lock(writeMtx);
+        size_t res = 0;
+        TNode* prev = nullptr;
+        TNode* p = pFirst.load(std::memory_order_relaxed);
+        while (p)
+        {
+            TNode* next = p->pNext.load(std::memory_order_relaxed);
+            if (pred(p->val))
+            {
+                retire(prev, p);
+                res++;
+            }
+            else
+                prev = p;
+            p = next;
+        }
+        return res;
+    }
+
+    // Удаляет первый элемент, равный val
+    bool erase(const T& val)
+    {
+        std::lock_guard<std::mutex> lock(writeMtx);
+        TNode* prev = nullptr;
+        for (TNode* p = pFirst.load(std::memory_order_relaxed); p; prev = p, p = p->pNext.load(std::memory_order_relaxed))
+        {
+            if (p->val == val)
+            {
+                retire(prev, p);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void clear()
+    {
+        erase_if([](const T&) { return true; });
+    }
+};
@@ -0,0 +1,309 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+#include "TList.h"
+
+// Упорядоченный TList с индексом в виде списка с пропусками.
+// Нижний уровень - сам TList; примерно каждый четвёртый элемент получает
+// «башню» индекса, каждый шестнадцатый - башню высоты 2 и т.д. Поиск
+// спускается по башням и заканчивает коротким линейным проходом по
+// списку, поэтому find, lower_bound и вставка с сохранением порядка
+// работают за ожидаемое O(log n). Равные ключи допускаются и хранятся в
+// порядке вставки. Изменять список можно только через индекс.
+template <class T, class Compare = std::less<T>>
+class TSkipIndex
+{
+public:
+    using const_iterator = typename TList<T>::const_iterator;
+
+private:
+    static constexpr int MaxLevel = 24;
+
+    struct TTower
+    {
+        const_iterator it;
+        int height;
+        TTower* next[1];    // фактически height элементов
+    };
+
+    TList<T> items;
+    TTower* heads[MaxLevel] = {};
+    int levels = 0;
+    Compare comp;
+    uint64_t rnd = 0x9E3779B97F4A7C15ull;
+
+    // Высота башни: 0 с вероятностью 3/4, далее каждый уровень с вероятностью 1/4
+    int randomHeight()
+    {
+        rnd ^= rnd << 13;
+        rnd ^= rnd >> 7;
+        rnd ^= rnd << 17;
+        uint64_t r = rnd;
+        int h = 0;
+        while ((r & 3) == 0 && h < MaxLevel)
+        {
+            h++;
+            r >>= 2;
+        }
+        return h;
+    }
+
+    static TTower* createTower(const_iterator it, int h)
+    {
+        void* mem = ::operator new(sizeof(TTower) + (h - 1) * sizeof(TTower*));
+        TTower* t = static_cast<TTower*>(mem);
+        ::new (&t->it) const_iterator(it);
+        t->height = h;
+        return t;
+    }
+
+    static void destroyTower(TTower* t)
+    {
+        ::operator delete(t);
+    }
+
+    TTower*& link(TTower* pred, int level)
+    {
+        return pred ? pred->next[level] : heads[level];
+    }
+
+    // Спуск по индексу: pred[l] - последняя башня уровня l, для которой
+    // goRight(ключ башни) истинно. Возвращает pred[0] или nullptr.
+    template <class GoRight>
+    TTower* descend(GoRight goRight, TTower** pred) const
+    {
+        TTower* t = nullptr;
+        for (int l = levels - 1; l >= 0; l--)
+        {
+            for (TTower* n = t ? t->next[l] : heads[l]; n && goRight(*n->it); n = n->next[l])
+                t = n;
+            if (pred)
+                pred[l] = t;
+        }
+        return t;
+    }
+
+    // Начало линейного прохода по списку от башни t
+    const_iterator scanFrom(TTower* t) const
+    {
+        return t ? t->it : items.begin();
+    }
+
+    void buildIndex()
+    {
+        TTower* tails[MaxLevel] = {};
+        for (const_iterator it = items.begin(); it != items.end(); ++it)
+        {
+            int h = randomHeight();
+            if (!h)
+                continue;
+            TTower* t = createTower(it, h);
+            for (int l = 0; l < h; l++)
+            {
+                t->next[l] = nullptr;
+                link(tails[l], l) = t;
+                tails[l] = t;
+            }
+            if (h > levels)
+                levels = h;
+        }
+    }
+
+    void stealIndex(TSkipIndex& other) noexcept
+    {
+        for (int l = 0; l < MaxLevel; l++)
+        {
+            heads[l] = other.heads[l];
+            other.heads[l] = nullptr;
+        }
+        levels = other.levels;
+        other.levels = 0;
+    }
+
+    void clearIndex()
+    {
+        TTower* t = levels ? heads[0] : nullptr;
+        while (t)
+        {
+            TTower* next = t->next[0];
+            destroyTower(t);
+            t = next;
+        }
+        for (TTower*& h : heads)
+            h = nullptr;
+        levels = 0;
+    }
+
+public:
+    TSkipIndex() = default;
+
+    explicit TSkipIndex(const Compare& c) : comp(c)
+    {
+    }
+
+    // Забирает список, сортирует его (устойчиво) и строит индекс за O(n)
+    explicit TSkipIndex(TList<T>&& l, const Compare& c = Compare()) : items(std::move(l)), comp(c)
+    {
+        items.sort(comp);
+        buildIndex();
+    }
+
+    TSkipIndex(const TSkipIndex& other) : items(other.items), comp(other.comp)
+    {
+        buildIndex();
+    }
+
+    TSkipIndex& operator=(const TSkipIndex& other)
+    {
+        if (this != &other)
+        {
+            clearIndex();
+            items = other.items;
+            comp = other.comp;
+            buildIndex();
+        }
+        return *this;
+    }
+
+    // Перемещающий конструктор забирает узлы списка вместе с ресурсом,
+    // поэтому башни остаются действительными и переходят без перестройки
+    TSkipIndex(TSkipIndex&& other) noexcept : items(std::move(other.items)), comp(other.comp)
+    {
+        stealIndex(other);
+    }
+
+    // При разных memory_resource список перемещается поэлементно в новые
+    // узлы, и индекс приходится строить заново
+    TSkipIndex& operator=(TSkipIndex&& other)
+    {
+        if (this != &other)
+        {
+            clearIndex();
+            comp = other.comp;
+            if (items.resource() == other.items.resource())
+            {
+                items = std::move(other.items);
+                stealIndex(other);
+            }
+            else
+            {
+                other.clearIndex();
+                items = std::move(other.items);
+                buildIndex();
+            }
+        }
+        return *this;
+    }
+
+    ~TSkipIndex()
+    {
+        clearIndex();
+    }
+
+    // Отдаёт список без индекса
+    TList<T> extract()
+    {
+        clearIndex();
+        return std::move(items);
+    }
+
+    const TList<T>& list() const noexcept { return items; }
+    const_iterator begin() const noexcept { return items.begin(); }
+    const_iterator end() const noexcept { return items.end(); }
+    size_t size() const noexcept { return items.size(); }
+    bool empty() const noexcept { return items.empty(); }
+
+    // Первый элемент, не меньший key
+    const_iterator lower_bound(const T& key) const
+    {
+        const_iterator it = scanFrom(descend([&](const T& v) { return comp(v, key); }, nullptr));
+        while (it != items.end() && comp(*it, key))
+            ++it;
+        return it;
+    }
+
+    // Первый элемент, больший key
+    const_iterator upper_bound(const T& key) const
+    {
+        const_iterator it = scanFrom(descend([&](const T& v) { return !comp(key, v); }, nullptr));
+        while (it != items.end() && !comp(key, *it))
+            ++it;
+        return it;
+    }
+
+    const_iterator find(const T& key) const
+    {
+        const_iterator it = lower_bound(key);
+        return it != items.end() && !comp(key, *it) ? it : items.end();
+    }
+
+    bool contains(const T& key) const
+    {
+        return find(key) != items.end();
+    }
+
+    // Вставка с сохранением порядка (после равных ключей)
+    const_iterator insert(const T& val)
+    {
+        TTower* pred[MaxLevel];
+        const_iterator it = scanFrom(descend([&](const T& v) { return !comp(val, v); }, pred));
+        while (it != items.end() && !comp(val, *it))
+            ++it;
+        it = items.insert(it, val);
+        int h = randomHeight();
+        if (h)
+        {
+            TTower* t = createTower(it, h);
+            for (int l = 0; l < h; l++)
+            {
+                TTower*& prev = link(l < levels ? pred[l] : nullptr, l);
+                t->next[l] = prev;
+                prev = t;
+            }
+            if (h > levels)
+                levels = h;
+        }
+        return it;
+    }
+
+    const_iterator erase(const_iterator pos)
+    {
+        const T& key = *pos;
+        TTower* pred[MaxLevel];
+        TTower* t = descend([&](const T& v) { return comp(v, key); }, pred);
+        // среди башен с равным ключом ищем башню самого pos
+        for (TTower* n = link(t, 0); n && !comp(key, *n->it); n = n->next[0])
+        {
+            if (n->it == pos)
+            {
+                for (int l = 0; l < n->height; l++)
+                    link(pred[l], l) = n->next[l];
+                destroyTower(n);
+                while (levels && !heads[levels - 1])
+                    levels--;
+                break;
+            }
+            for (int l = 0; l < n->height; l++)
+                pred[l] = n;
+        }
+        return items.erase(pos);
+    }
+
+    // Удаляет один элемент, равный key
+    bool erase(const T& key)
+    {
+        const_iterator it = find(key);
+        if (it == items.end())
+            return false;
+        erase(it);
+        return true;
+    }
+
+    void clear()
+    {
+        clearIndex();
+        items.clear();
+    }
+};
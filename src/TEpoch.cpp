@@ -0,0 +1,189 @@
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "TEpoch.h"
+#include "TList.h"
+
+namespace
+{
+
+struct TRetired
+{
+    void* p;
+    void (*del)(void*);
+    uint64_t epoch;
+};
+
+struct alignas(CacheLineSize) TRecord
+{
+    std::atomic<uint64_t> state{0};     // (эпоха << 1) | 1, если поток внутри
+    std::atomic<bool> used{true};
+    TRecord* pNext = nullptr;
+    unsigned nest = 0;
+    std::vector<TRetired> retired;
+};
+
+// Узлы потоков, завершившихся раньше, чем их узлы стало можно освободить
+struct TOrphans
+{
+    std::mutex mtx;
+    std::vector<TRetired> items;
+
+    ~TOrphans()
+    {
+        for (TRetired& r : items)
+            r.del(r.p);
+    }
+};
+
+const size_t CollectThreshold = 64;
+
+std::atomic<uint64_t> globalEpoch{1};
+std::atomic<TRecord*> records{nullptr};
+
+TOrphans& orphans()
+{
+    static TOrphans o;
+    return o;
+}
+
+TRecord* acquireRecord()
+{
+    for (TRecord* r = records.load(std::memory_order_acquire); r; r = r->pNext)
+    {
+        bool expected = false;
+        if (!r->used.load(std::memory_order_relaxed) &&
+            r->used.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            return r;
+    }
+    TRecord* r = new TRecord;
+    TRecord* head = records.load(std::memory_order_relaxed);
+    do
+        r->pNext = head;
+    while (!records.compare_exchange_weak(head, r, std::memory_order_release, std::memory_order_relaxed));
+    return r;
+}
+
+void tryAdvance()
+{
+    uint64_t g = globalEpoch.load(std::memory_order_acquire);
+    // парный к барьеру во входе читателя: либо мы увидим его состояние,
+    // либо он увидит уже отвязанные узлы
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (TRecord* r = records.load(std::memory_order_acquire); r; r = r->pNext)
+    {
+        uint64_t s = r->state.load(std::memory_order_acquire);
+        if ((s & 1) && (s >> 1) != g)
+            return;
+    }
+    globalEpoch.compare_exchange_strong(g, g + 1, std::memory_order_acq_rel);
+}
+
+void freeExpired(std::vector<TRetired>& items, uint64_t g)
+{
+    size_t keep = 0;
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        if (items[i].epoch + 2 <= g)
+            items[i].del(items[i].p);
+        else
+            items[keep++] = items[i];
+    }
+    items.resize(keep);
+}
+
+void collect(TRecord& rec)
+{
+    tryAdvance();
+    uint64_t g = globalEpoch.load(std::memory_order_acquire);
+    freeExpired(rec.retired, g);
+    TOrphans& o = orphans();
+    std::unique_lock<std::mutex> lock(o.mtx, std::try_to_lock);
+    if (lock.owns_lock())
+        freeExpired(o.items, g);
+}
+
+struct THolder
+{
+    TRecord* rec;
+
+    THolder() : rec(acquireRecord())
+    {
+        orphans();
+    }
+
+    ~THolder()
+    {
+        collect(*rec);
+        if (!rec->retired.empty())
+        {
+            TOrphans& o = orphans();
+            std::lock_guard<std::mutex> lock(o.mtx);
+            o.items.insert(o.items.end(), rec->retired.begin(), rec->retired.end());
+            rec->retired.clear();
+        }
+        rec->used.store(false, std::memory_order_release);
+    }
+};
+
+TRecord& local()
+{
+    thread_local THolder h;
+    return *h.rec;
+}
+
+}
+
+void TEpoch::enter()
+{
+    TRecord& r = local();
+    if (r.nest++ == 0)
+    {
+        uint64_t e = globalEpoch.load(std::memory_order_relaxed);
+        r.state.store((e << 1) | 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+void TEpoch::exit()
+{
+    TRecord& r = local();
+    if (--r.nest == 0)
+        r.state.store(0, std::memory_order_release);
+}
+
+void TEpoch::retire(void* p, void (*del)(void*))
+{
+    TRecord& r = local();
+    r.retired.push_back({p, del, globalEpoch.load(std::memory_order_acquire)});
+    if (r.retired.size() >= CollectThreshold)
+        ::collect(r);
+}
+
+void TEpoch::collect()
+{
+    ::collect(local());
+}
+
+void TEpoch::synchronize()
+{
+    TRecord& r = local();
+    if (r.nest)
+        throw std::logic_error("TEpoch::synchronize() inside a read-side section");
+    uint64_t target = globalEpoch.load(std::memory_order_acquire) + 2;
+    for (;;)
+    {
+        tryAdvance();
+        if (globalEpoch.load(std::memory_order_acquire) >= target)
+            break;
+        std::this_thread::yield();
+    }
+    ::collect(r);
+}
+
+uint64_t TEpoch::current()
+{
+    return globalEpoch.load(std::memory_order_acquire);
+}
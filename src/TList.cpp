@@ -1,12 +1,91 @@
-#include <iostream>
-#include <sstream>
-#include <string>
-#include "TList.h"
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include "TListIO.h"
 
+namespace
+{
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+}
 
-using namespace std;
+TTokenReader::TTokenReader(std::istream& s, size_t chunk) : is(s), buf(std::max<size_t>(chunk, 1))
+{
+}
+
+bool TTokenReader::refill()
+{
+    if (eof)
+        return false;
+    size_t tail = end - pos;
+    if (tail == buf.size())
+        buf.resize(buf.size() * 2);     // слово длиннее буфера
+    std::memmove(buf.data(), buf.data() + pos, tail);
+    pos = 0;
+    end = tail;
+    std::streamsize n = is.rdbuf()->sgetn(buf.data() + end, std::streamsize(buf.size() - end));
+    if (n <= 0)
+    {
+        eof = true;
+        return false;
+    }
+    end += size_t(n);
+    nread += uint64_t(n);
+    return true;
+}
+
+std::string_view TTokenReader::next()
+{
+    for (;;)
+    {
+        while (pos < end && isSpace(buf[pos]))
+            pos++;
+        if (pos < end)
+            break;
+        if (!refill())
+            return std::string_view();
+    }
+    size_t i = pos;
+    for (;;)
+    {
+        while (i < end && !isSpace(buf[i]))
+            i++;
+        if (i < end)
+            break;
+        // слово дошло до конца блока: дочитываем, сохраняя его начало
+        size_t off = i - pos;
+        bool more = refill();
+        i = pos + off;
+        if (!more)
+            break;
+    }
+    std::string_view tok(buf.data() + pos, i - pos);
+    pos = i;
+    return tok;
+}
+
+TTokenWriter::TTokenWriter(std::ostream& s, size_t chunk) : os(s), buf(std::max<size_t>(chunk, 1))
+{
+}
+
+char* TTokenWriter::reserve(size_t n)
+{
+    if (used + n > buf.size())
+    {
+        flush();
+        if (n > buf.size())
+            buf.resize(n);
+    }
+    return buf.data() + used;
+}
 
-int main()
+void TTokenWriter::flush()
 {
-    return 0;
-}
\ No newline at end of file
+    os.write(buf.data(), std::streamsize(used));
+    used = 0;
+}
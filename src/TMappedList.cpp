@@ -0,0 +1,76 @@
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "TMappedList.h"
+
+namespace
+{
+
+[[noreturn]] void fail(const std::string& what)
+{
+    throw std::runtime_error("TMappedFile: " + what + ": " + std::strerror(errno));
+}
+
+}
+
+TMappedFile::TMappedFile(const std::string& path, size_t minSize)
+{
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        fail("cannot open " + path);
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        fail("cannot stat " + path);
+    }
+    len = size_t(st.st_size);
+    if (len == 0)
+    {
+        // новый файл заполняется нулями, ftruncate не пишет на диск
+        if (::ftruncate(fd, off_t(minSize)) != 0)
+        {
+            ::close(fd);
+            fail("cannot resize " + path);
+        }
+        len = minSize;
+        created = true;
+    }
+    void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+    {
+        ::close(fd);
+        fail("cannot map " + path);
+    }
+    pBase = static_cast<char*>(p);
+}
+
+TMappedFile::~TMappedFile()
+{
+    ::munmap(pBase, len);
+    ::close(fd);
+}
+
+void TMappedFile::grow(size_t n)
+{
+    if (n <= len)
+        return;
+    if (::ftruncate(fd, off_t(n)) != 0)
+        fail("cannot resize");
+    void* p = ::mremap(pBase, len, n, MREMAP_MAYMOVE);
+    if (p == MAP_FAILED)
+        fail("cannot remap");
+    pBase = static_cast<char*>(p);
+    len = n;
+}
+
+void TMappedFile::sync()
+{
+    if (::msync(pBase, len, MS_SYNC) != 0)
+        fail("msync");
+}
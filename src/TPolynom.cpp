@@ -0,0 +1,503 @@
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "TParallel.h"
+#include "TPolynom.h"
+
+namespace
+{
+
+// x^e возведением в квадрат
+double ipow(double x, unsigned e)
+{
+    double res = 1;
+    while (e)
+    {
+        if (e & 1)
+            res *= x;
+        x *= x;
+        e >>= 1;
+    }
+    return res;
+}
+
+// Ядра пакетного вычисления собираются в нескольких вариантах, нужный
+// выбирается при загрузке по возможностям процессора. Под ThreadSanitizer
+// клоны отключены: их ifunc-резолверы вызываются до инициализации рантайма
+// TSan, и программа падает при старте.
+#if defined(__SANITIZE_THREAD__)
+#define EVAL_NO_CLONES
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define EVAL_NO_CLONES
+#endif
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__) && !defined(EVAL_NO_CLONES)
+#define EVAL_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define EVAL_CLONES
+#endif
+
+// Член в пакетном вычислении: коэффициент и строки таблиц степеней
+struct TEvalTerm
+{
+    double coef;
+    uint32_t row[TMonom::VarCount];
+};
+
+// Точек в блоке кратно EvalLanes, не больше EvalMaxBlock; размер блока
+// подбирается так, чтобы таблицы степеней занимали около EvalTableBytes
+constexpr size_t EvalLanes = 8;
+constexpr size_t EvalMaxBlock = 64;
+constexpr size_t EvalTableBytes = 256 * 1024;
+
+// Строки таблицы степеней: row[k][l] = pts[l]^exps[k]. Возведение в
+// квадрат идёт по общему для всех точек показателю, поэтому циклы по
+// точкам не ветвятся.
+EVAL_CLONES
+void powerTable(const std::vector<unsigned>& exps, const double* pts, size_t b, double* table)
+{
+    double base[EvalMaxBlock];
+    unsigned prevExp = 0;
+    for (size_t k = 0; k < exps.size(); k++)
+    {
+        double* row = table + k * b;
+        const double* prev = k ? row - b : nullptr;
+        for (size_t l = 0; l < b; l++)
+        {
+            row[l] = prev ? prev[l] : 1.0;
+            base[l] = pts[l];
+        }
+        for (unsigned e = exps[k] - prevExp; e; e >>= 1)
+        {
+            if (e & 1)
+                for (size_t l = 0; l < b; l++)
+                    row[l] *= base[l];
+            for (size_t l = 0; l < b; l++)
+                base[l] *= base[l];
+        }
+        prevExp = exps[k];
+    }
+}
+
+// acc[l] = сумма coef * tx[l] * ty[l] * tz[l] по всем членам
+EVAL_CLONES
+void accumulateTerms(const TEvalTerm* terms, size_t n, const double* tx, const double* ty, const double* tz, size_t b, double* acc)
+{
+    for (size_t l = 0; l < b; l++)
+        acc[l] = 0;
+    for (size_t t = 0; t < n; t++)
+    {
+        double c = terms[t].coef;
+        const double* px = tx + terms[t].row[0] * b;
+        const double* py = ty + terms[t].row[1] * b;
+        const double* pz = tz + terms[t].row[2] * b;
+        for (size_t l = 0; l < b; l++)
+            acc[l] += c * px[l] * py[l] * pz[l];
+    }
+}
+
+}
+
+TPolynom::TPolynom(std::initializer_list<TMonom> il) : TPolynom(TList<TMonom>(il))
+{
+}
+
+TPolynom::TPolynom(TList<TMonom> l) : terms(std::move(l))
+{
+    terms.sort([](const TMonom& a, const TMonom& b) { return a.key > b.key; });
+    auto it = terms.begin();
+    while (it != terms.end())
+    {
+        auto next = std::next(it);
+        while (next != terms.end() && next->key == it->key)
+        {
+            it->coef += next->coef;
+            next = terms.erase(next);
+        }
+        it = it->coef == 0 ? terms.erase(it) : next;
+    }
+}
+
+void TPolynom::addScaled(const TPolynom& q, double k)
+{
+    if (&q == this)
+    {
+        TPolynom copy(q);
+        addScaled(copy, k);
+        return;
+    }
+    auto it = terms.begin();
+    for (const TMonom& m : q.terms)
+    {
+        double c = k * m.coef;
+        while (it != terms.end() && it->key > m.key)
+            ++it;
+        if (it != terms.end() && it->key == m.key)
+        {
+            it->coef += c;
+            it = it->coef == 0 ? terms.erase(it) : std::next(it);
+        }
+        else if (c != 0)
+            terms.emplace(it, c, m.key);
+    }
+}
+
+uint64_t TPolynom::maxExps() const
+{
+    uint64_t res = 0;
+    for (const TMonom& m : terms)
+        res = TMonom::TExps::max(res, m.key);
+    return res;
+}
+
+// Куча строк «член a[i] на члены b» (алгоритм Джонсона). Строка i+1
+// попадает в кучу, когда из неё вынут первый член строки i: раньше её
+// члены не могут оказаться наибольшими. Поэтому куча обычно много меньше n.
+TPolynom TPolynom::mulHeap(TTermIt first, TTermIt last, const TPolynom& b)
+{
+    struct TEntry
+    {
+        uint64_t key;
+        size_t row;
+        TList<TMonom>::const_iterator it;
+
+        bool operator<(const TEntry& e) const { return key < e.key; }
+    };
+
+    std::vector<TMonom> rows(first, last);
+    std::vector<TEntry> heap;
+    heap.reserve(rows.size());
+    heap.push_back({TMonom::TExps::mul(rows[0].key, b.terms.front().key), 0, b.terms.begin()});
+    TPolynom res;
+    uint64_t key = heap.front().key;
+    double c = 0;
+    while (!heap.empty())
+    {
+        std::pop_heap(heap.begin(), heap.end());
+        TEntry& e = heap.back();
+        if (e.key != key)
+        {
+            if (c != 0)
+                res.terms.emplace_back(c, key);
+            key = e.key;
+            c = 0;
+        }
+        c += rows[e.row].coef * e.it->coef;
+        if (e.it == b.terms.begin() && e.row + 1 < rows.size())
+        {
+            size_t next = e.row + 1;
+            if (++e.it != b.terms.end())
+            {
+                e.key = TMonom::TExps::mul(rows[e.row].key, e.it->key);
+                std::push_heap(heap.begin(), heap.end());
+            }
+            else
+                heap.pop_back();
+            heap.push_back({TMonom::TExps::mul(rows[next].key, b.terms.front().key), next, b.terms.begin()});
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else if (++e.it != b.terms.end())
+        {
+            e.key = TMonom::TExps::mul(rows[e.row].key, e.it->key);
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else
+            heap.pop_back();
+    }
+    if (c != 0)
+        res.terms.emplace_back(c, key);
+    return res;
+}
+
+// Все n*m произведений складываются в хеш-таблице, затем сортируются
+TPolynom TPolynom::mulHash(TTermIt first, TTermIt last, const TPolynom& b)
+{
+    std::unordered_map<uint64_t, double> acc;
+    acc.reserve(b.size());
+    for (; first != last; ++first)
+        for (const TMonom& y : b.terms)
+            acc[TMonom::TExps::mul(first->key, y.key)] += first->coef * y.coef;
+    std::vector<std::pair<uint64_t, double>> sorted(acc.begin(), acc.end());
+    acc = std::unordered_map<uint64_t, double>();
+    std::sort(sorted.begin(), sorted.end(), [](const auto& l, const auto& r) { return l.first > r.first; });
+    TPolynom res;
+    res.terms.reserve(sorted.size());
+    for (const auto& t : sorted)
+        if (t.second != 0)
+            res.terms.emplace_back(t.second, t.first);
+    return res;
+}
+
+TMulMethod TPolynom::prepareProduct(const TPolynom& a, const TPolynom& b, TMulMethod method)
+{
+    // наибольшая степень каждой переменной в произведении достигается,
+    // поэтому переполнение проверяется один раз для всех пар членов
+    uint64_t top = TMonom::TExps::mul(a.maxExps(), b.maxExps());
+    if (TMonom::TExps::overflowed(top))
+        throw std::overflow_error("TMonom: exponent overflow in product");
+    double box = 1;
+    for (int v = 0; v < TMonom::VarCount; v++)
+        box *= TMonom::TExps::get(top, v) + 1;
+    if (method != TMulMethod::Auto)
+        return method;
+    return double(a.size()) * double(b.size()) >= HashDensity * box ? TMulMethod::Hash : TMulMethod::Heap;
+}
+
+TPolynom TPolynom::mulRange(TTermIt first, TTermIt last, const TPolynom& b, TMulMethod method)
+{
+    if (std::next(first) == last)
+    {
+        TPolynom res(b);
+        for (TMonom& t : res.terms)
+        {
+            t.coef *= first->coef;
+            t.key = TMonom::TExps::mul(t.key, first->key);
+        }
+        return res;
+    }
+    return method == TMulMethod::Hash ? mulHash(first, last, b) : mulHeap(first, last, b);
+}
+
+TPolynom TPolynom::multiply(const TPolynom& p, const TPolynom& q, TMulMethod method)
+{
+    const TPolynom& a = p.size() <= q.size() ? p : q;
+    const TPolynom& b = p.size() <= q.size() ? q : p;
+    if (a.empty())
+        return TPolynom();
+    method = prepareProduct(a, b, method);
+    return mulRange(a.terms.begin(), a.terms.end(), b, method);
+}
+
+// Меньший множитель режется на куски подряд идущих членов, каждый поток
+// умножает свой кусок на весь второй множитель. Частичные произведения
+// упорядочены и попарно сливаются (пары - параллельно) перевешиванием
+// узлов, без промежуточных массивов.
+TPolynom TPolynom::parallel_multiply(const TPolynom& p, const TPolynom& q, unsigned threads, TMulMethod method)
+{
+    const TPolynom& a = p.size() <= q.size() ? p : q;
+    const TPolynom& b = p.size() <= q.size() ? q : p;
+    if (a.empty())
+        return TPolynom();
+    if (!threads)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t products = a.size() * b.size();
+    size_t chunks = std::min({size_t(threads), a.size(), products / ParallelMulGrain});
+    if (chunks < 2)
+        return multiply(a, b, method);
+    method = prepareProduct(a, b, method);
+
+    std::vector<TTermIt> bounds(chunks + 1);
+    TTermIt it = a.terms.begin();
+    for (size_t i = 0; i < chunks; i++)
+    {
+        bounds[i] = it;
+        std::advance(it, a.size() / chunks + (i < a.size() % chunks ? 1 : 0));
+    }
+    bounds[chunks] = it;
+
+    std::vector<TPolynom> parts(chunks);
+    runParallel(chunks, [&](size_t i) { parts[i] = mulRange(bounds[i], bounds[i + 1], b, method); });
+    while (parts.size() > 1)
+    {
+        size_t pairs = parts.size() / 2;
+        runParallel(pairs, [&parts](size_t i) { parts[2 * i] += std::move(parts[2 * i + 1]); });
+        for (size_t i = 0; i < pairs; i++)
+            parts[i] = std::move(parts[2 * i]);
+        if (parts.size() % 2)
+            parts[pairs++] = std::move(parts.back());
+        parts.resize(pairs);
+    }
+    return std::move(parts[0]);
+}
+
+double TPolynom::coef(unsigned x, unsigned y, unsigned z) const
+{
+    uint64_t key = TMonom::TExps::pack(x, y, z);
+    for (const TMonom& m : terms)
+    {
+        if (m.key == key)
+            return m.coef;
+        if (m.key < key)
+            break;
+    }
+    return 0;
+}
+
+TPolynom& TPolynom::operator+=(const TPolynom& q)
+{
+    addScaled(q, 1);
+    return *this;
+}
+
+// Узлы q переносятся в *this; совпавшие члены складываются
+TPolynom& TPolynom::operator+=(TPolynom&& q)
+{
+    if (&q == this)
+        return *this += static_cast<const TPolynom&>(q);
+    auto it = terms.begin();
+    while (!q.terms.empty())
+    {
+        if (it == terms.end())
+        {
+            terms.splice(it, q.terms);
+            break;
+        }
+        const TMonom& m = q.terms.front();
+        if (it->key > m.key)
+            ++it;
+        else if (it->key == m.key)
+        {
+            it->coef += m.coef;
+            q.terms.pop_front();
+            if (it->coef == 0)
+                it = terms.erase(it);
+        }
+        else
+            terms.splice(it, q.terms, q.terms.begin());
+    }
+    return *this;
+}
+
+TPolynom& TPolynom::operator-=(const TPolynom& q)
+{
+    addScaled(q, -1);
+    return *this;
+}
+
+TPolynom& TPolynom::operator*=(const TPolynom& q)
+{
+    *this = multiply(*this, q);
+    return *this;
+}
+
+TPolynom& TPolynom::operator*=(double k)
+{
+    if (k == 0)
+    {
+        terms.clear();
+        return *this;
+    }
+    for (TMonom& m : terms)
+        m.coef *= k;
+    return *this;
+}
+
+TPolynom TPolynom::operator+(const TPolynom& q) const
+{
+    TPolynom res(*this);
+    res += q;
+    return res;
+}
+
+TPolynom TPolynom::operator-(const TPolynom& q) const
+{
+    TPolynom res(*this);
+    res -= q;
+    return res;
+}
+
+TPolynom TPolynom::operator*(const TPolynom& q) const
+{
+    TPolynom res(*this);
+    res *= q;
+    return res;
+}
+
+TPolynom TPolynom::operator*(double k) const
+{
+    TPolynom res(*this);
+    res *= k;
+    return res;
+}
+
+TPolynom TPolynom::operator-() const
+{
+    return *this * -1.0;
+}
+
+double TPolynom::operator()(double x, double y, double z) const
+{
+    double res = 0;
+    for (const TMonom& m : terms)
+        res += m.coef * ipow(x, m.exp(0)) * ipow(y, m.exp(1)) * ipow(z, m.exp(2));
+    return res;
+}
+
+void TPolynom::evaluate(const double* x, const double* y, const double* z, size_t n, double* out) const
+{
+    if (terms.empty())
+    {
+        std::fill(out, out + n, 0.0);
+        return;
+    }
+
+    // различные степени каждой переменной - строки таблиц
+    std::vector<unsigned> exps[TMonom::VarCount];
+    std::vector<uint32_t> rowOf[TMonom::VarCount];
+    for (int v = 0; v < TMonom::VarCount; v++)
+    {
+        std::vector<bool> used;
+        for (const TMonom& m : terms)
+        {
+            unsigned e = m.exp(v);
+            if (e >= used.size())
+                used.resize(e + 1);
+            used[e] = true;
+        }
+        rowOf[v].resize(used.size());
+        for (unsigned e = 0; e < used.size(); e++)
+        {
+            if (used[e])
+            {
+                rowOf[v][e] = uint32_t(exps[v].size());
+                exps[v].push_back(e);
+            }
+        }
+    }
+
+    // единственный проход по списку: члены в плотный массив
+    std::vector<TEvalTerm> flat;
+    flat.reserve(terms.size());
+    for (const TMonom& m : terms)
+        flat.push_back({m.coef, {rowOf[0][m.exp(0)], rowOf[1][m.exp(1)], rowOf[2][m.exp(2)]}});
+
+    size_t rows = exps[0].size() + exps[1].size() + exps[2].size();
+    size_t b = EvalTableBytes / (rows * sizeof(double)) / EvalLanes * EvalLanes;
+    b = std::max(EvalLanes, std::min(b, EvalMaxBlock));
+    std::vector<double> table(rows * b);
+    double* tx = table.data();
+    double* ty = tx + exps[0].size() * b;
+    double* tz = ty + exps[1].size() * b;
+    double px[EvalMaxBlock], py[EvalMaxBlock], pz[EvalMaxBlock], acc[EvalMaxBlock];
+    for (size_t first = 0; first < n; first += b)
+    {
+        size_t cnt = std::min(b, n - first);
+        for (size_t l = 0; l < b; l++)
+        {
+            // недостающие точки блока заполняются единицами
+            px[l] = l < cnt ? x[first + l] : 1;
+            py[l] = l < cnt ? y[first + l] : 1;
+            pz[l] = l < cnt ? z[first + l] : 1;
+        }
+        powerTable(exps[0], px, b, tx);
+        powerTable(exps[1], py, b, ty);
+        powerTable(exps[2], pz, b, tz);
+        accumulateTerms(flat.data(), flat.size(), tx, ty, tz, b, acc);
+        std::copy(acc, acc + cnt, out + first);
+    }
+}
+
+std::vector<double> TPolynom::evaluate(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z) const
+{
+    if (x.size() != y.size() || x.size() != z.size())
+        throw std::invalid_argument("TPolynom::evaluate: coordinate arrays differ in size");
+    std::vector<double> res(x.size());
+    evaluate(x.data(), y.data(), z.data(), x.size(), res.data());
+    return res;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <type_traits>
+#include <vector>
+
+// Элементы контейнера (или представления) в порядке обхода
+template <class C>
+auto toVector(const C& c)
+{
+    using T = std::decay_t<decltype(*c.begin())>;
+    return std::vector<T>(c.begin(), c.end());
+}
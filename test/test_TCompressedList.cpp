@@ -0,0 +1,124 @@
+#include <gtest.h>
+#include "TCompressedList.h"
+#include "TTestUtils.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Возрастающие значения с разностями разной ширины
+static vector<uint64_t> sortedIds(size_t n)
+{
+    vector<uint64_t> res(n);
+    uint64_t v = 1000, seed = 7;
+    for (size_t i = 0; i < n; i++)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        v += (seed >> 33) % (i % 300 == 0 ? 1000000 : 50);
+        res[i] = v;
+    }
+    return res;
+}
+
+TEST(TCompressedList, empty_list_has_no_elements)
+{
+    TCompressedList<> l;
+
+    EXPECT_TRUE(l.empty());
+    EXPECT_TRUE(l.begin() == l.end());
+    ASSERT_ANY_THROW(l.front());
+}
+
+TEST(TCompressedList, keeps_values_across_blocks)
+{
+    vector<uint64_t> ids = sortedIds(1000);
+    TCompressedList<> l(ids.begin(), ids.end());
+
+    EXPECT_EQ(1000u, l.size());
+    EXPECT_EQ(1000 / TCompressedList<>::BlockSize, l.block_count());
+    EXPECT_EQ(ids, toVector(l));
+    EXPECT_EQ(ids.front(), l.front());
+    EXPECT_EQ(ids.back(), l.back());
+}
+
+TEST(TCompressedList, handles_equal_and_extreme_values)
+{
+    vector<uint64_t> v(200, 5);
+    v.push_back(UINT64_MAX);
+    for (int i = 0; i < 200; i++)
+        v.push_back(UINT64_MAX);
+    TCompressedList<> l(v.begin(), v.end());
+
+    EXPECT_EQ(v, toVector(l));
+}
+
+TEST(TCompressedList, handles_full_width_deltas)
+{
+    vector<uint64_t> sorted = {0};
+    for (size_t i = 0; i < 300; i++)
+        sorted.push_back(i < 150 ? i : UINT64_MAX - 300 + i);
+    TCompressedList<> l(sorted.begin(), sorted.end());
+
+    EXPECT_EQ(sorted, toVector(l));
+}
+
+TEST(TCompressedList, works_with_32_bit_values)
+{
+    vector<uint32_t> v;
+    for (uint32_t i = 0; i < 1000; i++)
+        v.push_back(i * 4000000u);
+    TCompressedList<uint32_t> l(v.begin(), v.end());
+
+    EXPECT_EQ(v, toVector(l));
+}
+
+TEST(TCompressedList, push_back_rejects_decreasing_value)
+{
+    TCompressedList<> l = {1, 5};
+
+    ASSERT_ANY_THROW(l.push_back(4));
+    EXPECT_EQ(2u, l.size());
+}
+
+TEST(TCompressedList, can_find_values)
+{
+    vector<uint64_t> ids = sortedIds(5000);
+    TCompressedList<> l(ids.begin(), ids.end());
+
+    for (size_t i = 0; i < ids.size(); i += 37)
+        EXPECT_TRUE(l.contains(ids[i]));
+    EXPECT_TRUE(l.contains(ids.back()));
+    EXPECT_FALSE(l.contains(0));
+    EXPECT_FALSE(l.contains(ids.back() + 1));
+}
+
+TEST(TCompressedList, dense_ids_take_far_less_memory_than_nodes)
+{
+    vector<uint64_t> ids = sortedIds(100000);
+    TCompressedList<> l(ids.begin(), ids.end());
+
+    // разности до 50 укладываются в 6 бит, редкие большие скачки расширяют блок
+    EXPECT_LT(l.bytes_used(), ids.size() * 3);
+}
+
+TEST(TCompressedList, can_convert_to_list)
+{
+    TList<uint64_t> src;
+    for (uint64_t i = 0; i < 500; i++)
+        src.push_back(i * i);
+    TCompressedList<> l(src);
+    TList<uint64_t> back = l.to_list();
+
+    EXPECT_TRUE(src == back);
+}
+
+TEST(TCompressedList, for_each_visits_all_values_in_order)
+{
+    vector<uint64_t> ids = sortedIds(777);
+    TCompressedList<> l(ids.begin(), ids.end());
+    vector<uint64_t> seen;
+    l.for_each([&](uint64_t v) { seen.push_back(v); });
+
+    EXPECT_EQ(ids, seen);
+}
@@ -0,0 +1,111 @@
+#include <gtest.h>
+#include "TConcurrentList.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+template <class T>
+static vector<T> toVector(const TConcurrentList<T>& l)
+{
+    vector<T> res;
+    l.for_each([&res](const T& v) { res.push_back(v); });
+    return res;
+}
+
+TEST(TConcurrentList, can_insert_keys_in_order)
+{
+    TConcurrentList<int> l;
+
+    EXPECT_TRUE(l.insert(3));
+    EXPECT_TRUE(l.insert(1));
+    EXPECT_TRUE(l.insert(2));
+    EXPECT_FALSE(l.insert(2));
+    EXPECT_EQ(vector<int>({1, 2, 3}), toVector(l));
+}
+
+TEST(TConcurrentList, can_erase_and_check_keys)
+{
+    TConcurrentList<string> l;
+    l.insert("a");
+    l.insert("b");
+
+    EXPECT_TRUE(l.contains("a"));
+    EXPECT_TRUE(l.erase("a"));
+    EXPECT_FALSE(l.erase("a"));
+    EXPECT_FALSE(l.contains("a"));
+    EXPECT_TRUE(l.contains("b"));
+    EXPECT_FALSE(l.contains("c"));
+}
+
+TEST(TConcurrentList, concurrent_inserts_of_disjoint_keys_are_all_visible)
+{
+    TConcurrentList<int> l;
+    const int threads = 8, perThread = 2000;
+    vector<thread> ws;
+    for (int t = 0; t < threads; t++)
+        ws.emplace_back([&l, t] {
+            for (int i = 0; i < perThread; i++)
+                l.insert(i * threads + t);
+        });
+    for (thread& w : ws)
+        w.join();
+
+    vector<int> v = toVector(l);
+    ASSERT_EQ(size_t(threads * perThread), v.size());
+    for (int i = 0; i < threads * perThread; i++)
+        EXPECT_EQ(i, v[i]);
+}
+
+TEST(TConcurrentList, concurrent_erase_removes_each_key_once)
+{
+    TConcurrentList<int> l;
+    const int keys = 5000, threads = 8;
+    for (int i = 0; i < keys; i++)
+        l.insert(i);
+    vector<int> erased(threads, 0);
+    vector<thread> ws;
+    for (int t = 0; t < threads; t++)
+        ws.emplace_back([&l, &erased, t] {
+            for (int i = 0; i < keys; i++)
+                if (l.erase(i))
+                    erased[t]++;
+        });
+    for (thread& w : ws)
+        w.join();
+
+    int total = 0;
+    for (int e : erased)
+        total += e;
+    EXPECT_EQ(keys, total);
+    EXPECT_TRUE(toVector(l).empty());
+}
+
+TEST(TConcurrentList, mixed_workload_keeps_even_keys)
+{
+    TConcurrentList<int> l;
+    const int keys = 1000;
+    vector<thread> ws;
+    for (int t = 0; t < 4; t++)
+        ws.emplace_back([&l] {
+            for (int i = 0; i < keys; i++)
+                l.insert(i);
+        });
+    for (int t = 0; t < 4; t++)
+        ws.emplace_back([&l] {
+            for (int r = 0; r < 3; r++)
+                for (int i = 1; i < keys; i += 2)
+                    l.erase(i);
+        });
+    for (thread& w : ws)
+        w.join();
+    for (int i = 1; i < keys; i += 2)
+        l.erase(i);
+
+    vector<int> v = toVector(l);
+    ASSERT_EQ(size_t(keys / 2), v.size());
+    for (int i = 0; i < keys / 2; i++)
+        EXPECT_EQ(2 * i, v[i]);
+}
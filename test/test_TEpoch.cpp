@@ -0,0 +1,61 @@
+#include <gtest.h>
+#include "TEpoch.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+static atomic<int> freed{0};
+
+struct TCounted
+{
+    ~TCounted() { freed++; }
+};
+
+TEST(TEpoch, retired_object_is_freed_after_grace_period)
+{
+    freed = 0;
+    TEpoch::retire(new TCounted);
+    TEpoch::synchronize();
+
+    EXPECT_EQ(1, freed);
+}
+
+TEST(TEpoch, active_reader_delays_reclamation)
+{
+    freed = 0;
+    atomic<bool> entered{false}, leave{false};
+    thread reader([&] {
+        TEpoch::TGuard g;
+        entered = true;
+        while (!leave)
+            this_thread::yield();
+    });
+    while (!entered)
+        this_thread::yield();
+    TEpoch::retire(new TCounted);
+    for (int i = 0; i < 10; i++)
+        TEpoch::collect();
+
+    EXPECT_EQ(0, freed);
+    leave = true;
+    reader.join();
+    TEpoch::synchronize();
+    EXPECT_EQ(1, freed);
+}
+
+TEST(TEpoch, synchronize_inside_read_section_throws)
+{
+    TEpoch::TGuard g;
+
+    ASSERT_ANY_THROW(TEpoch::synchronize());
+}
+
+TEST(TEpoch, epoch_advances_without_readers)
+{
+    uint64_t e = TEpoch::current();
+    TEpoch::synchronize();
+
+    EXPECT_GE(TEpoch::current(), e + 2);
+}
@@ -0,0 +1,132 @@
+#include <gtest.h>
+#include "TIntrusiveList.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct TSession
+{
+    int id;
+    TListHook stateHook;
+    TListHook allHook;
+
+    explicit TSession(int i) : id(i)
+    {
+    }
+};
+
+using TStateQueue = TIntrusiveList<TSession, &TSession::stateHook>;
+using TAllSessions = TIntrusiveList<TSession, &TSession::allHook>;
+
+template <class L>
+static vector<int> ids(const L& l)
+{
+    vector<int> res;
+    for (const TSession& s : l)
+        res.push_back(s.id);
+    return res;
+}
+
+TEST(TIntrusiveList, can_link_elements)
+{
+    TSession a(1), b(2), c(3);
+    TStateQueue q;
+    q.push_back(b);
+    q.push_back(c);
+    q.push_front(a);
+
+    EXPECT_EQ(vector<int>({1, 2, 3}), ids(q));
+    EXPECT_EQ(3u, q.size());
+    EXPECT_TRUE(b.stateHook.is_linked());
+    EXPECT_FALSE(b.allHook.is_linked());
+}
+
+TEST(TIntrusiveList, element_can_be_in_several_lists)
+{
+    TSession a(1), b(2);
+    TStateQueue idle;
+    TAllSessions all;
+    all.push_back(a);
+    all.push_back(b);
+    idle.push_back(b);
+
+    EXPECT_EQ(vector<int>({1, 2}), ids(all));
+    EXPECT_EQ(vector<int>({2}), ids(idle));
+    EXPECT_EQ(&b, &idle.front());
+}
+
+TEST(TIntrusiveList, can_move_element_between_queues)
+{
+    TSession a(1), b(2);
+    TStateQueue idle, active;
+    idle.push_back(a);
+    idle.push_back(b);
+    active.splice(active.end(), idle, idle.iterator_to(a));
+
+    EXPECT_EQ(vector<int>({2}), ids(idle));
+    EXPECT_EQ(vector<int>({1}), ids(active));
+    active.remove(a);
+    idle.push_front(a);
+    EXPECT_EQ(vector<int>({1, 2}), ids(idle));
+    EXPECT_TRUE(active.empty());
+}
+
+TEST(TIntrusiveList, throws_when_linking_linked_element)
+{
+    TSession a(1);
+    TStateQueue q1, q2;
+    q1.push_back(a);
+
+    ASSERT_ANY_THROW(q2.push_back(a));
+}
+
+TEST(TIntrusiveList, throws_when_removing_unlinked_element)
+{
+    TSession a(1), b(2);
+    TStateQueue q;
+    q.push_back(a);
+
+    ASSERT_THROW(q.remove(b), logic_error);
+    ASSERT_THROW(q.erase(TStateQueue::iterator_to(b)), logic_error);
+    q.remove(a);
+    ASSERT_THROW(q.remove(a), logic_error);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(TIntrusiveList, throws_when_removing_element_of_other_list)
+{
+    TSession a(1), b(2);
+    TStateQueue q, other;
+    q.push_back(a);
+    other.push_back(b);
+
+    ASSERT_THROW(q.remove(b), logic_error);
+    ASSERT_THROW(q.splice(q.end(), q, TStateQueue::iterator_to(b)), logic_error);
+    EXPECT_EQ(1u, q.size());
+    EXPECT_EQ(vector<int>({2}), ids(other));
+}
+
+TEST(TIntrusiveList, destroyed_list_unlinks_elements)
+{
+    TSession a(1);
+    {
+        TStateQueue q;
+        q.push_back(a);
+    }
+
+    EXPECT_FALSE(a.stateHook.is_linked());
+}
+
+TEST(TIntrusiveList, copy_of_element_is_not_linked)
+{
+    TSession a(1);
+    TStateQueue q;
+    q.push_back(a);
+    TSession b = a;
+
+    EXPECT_FALSE(b.stateHook.is_linked());
+    q.pop_back();
+    EXPECT_TRUE(q.empty());
+}
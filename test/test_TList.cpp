@@ -1,2 +1,593 @@
 #include <gtest.h>
-#include "TList.h"
\ No newline at end of file
+#include "TList.h"
+#include "TTestUtils.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+template <class T>
+static bool isContiguous(const TList<T>& l)
+{
+    const T* prev = nullptr;
+    for (const T& v : l)
+    {
+        if (prev && reinterpret_cast<const char*>(&v) - reinterpret_cast<const char*>(prev) != sizeof(TListNode<T>))
+            return false;
+        prev = &v;
+    }
+    return true;
+}
+
+TEST(TList, can_create_empty_list)
+{
+    TList<int> l;
+
+    EXPECT_TRUE(l.empty());
+    EXPECT_EQ(0u, l.size());
+    EXPECT_TRUE(l.begin() == l.end());
+}
+
+TEST(TList, can_push_and_pop)
+{
+    TList<int> l;
+    l.push_back(2);
+    l.push_back(3);
+    l.push_front(1);
+
+    EXPECT_EQ(vector<int>({1, 2, 3}), toVector(l));
+    l.pop_front();
+    l.pop_back();
+    EXPECT_EQ(vector<int>({2}), toVector(l));
+}
+
+TEST(TList, throws_when_pop_from_empty_list)
+{
+    TList<int> l;
+
+    ASSERT_ANY_THROW(l.pop_front());
+    ASSERT_ANY_THROW(l.pop_back());
+    ASSERT_ANY_THROW(l.front());
+}
+
+TEST(TList, can_insert_and_erase_at_iterator)
+{
+    TList<int> l = {1, 2, 4};
+    auto it = l.find(4);
+    l.insert(it, 3);
+    it = l.erase(l.find(1));
+
+    EXPECT_EQ(2, *it);
+    EXPECT_EQ(vector<int>({2, 3, 4}), toVector(l));
+}
+
+TEST(TList, find_returns_end_for_missing_value)
+{
+    TList<int> l = {1, 2, 3};
+
+    EXPECT_TRUE(l.find(5) == l.end());
+}
+
+TEST(TList, copied_list_is_equal_and_independent)
+{
+    TList<string> l = {"a", "b"};
+    TList<string> c(l);
+
+    EXPECT_EQ(l, c);
+    c.push_back("c");
+    EXPECT_NE(l, c);
+    EXPECT_EQ(2u, l.size());
+}
+
+TEST(TList, can_move_list)
+{
+    TList<int> l = {1, 2, 3};
+    TList<int> m(std::move(l));
+
+    EXPECT_TRUE(l.empty());
+    EXPECT_EQ(vector<int>({1, 2, 3}), toVector(m));
+    l = std::move(m);
+    EXPECT_EQ(vector<int>({1, 2, 3}), toVector(l));
+}
+
+TEST(TList, can_swap_lists)
+{
+    TList<int> a = {1, 2};
+    TList<int> b = {3};
+    a.swap(b);
+
+    EXPECT_EQ(vector<int>({3}), toVector(a));
+    EXPECT_EQ(vector<int>({1, 2}), toVector(b));
+}
+
+TEST(TList, can_iterate_backwards)
+{
+    TList<int> l = {1, 2, 3};
+
+    EXPECT_EQ(vector<int>({3, 2, 1}), vector<int>(l.rbegin(), l.rend()));
+}
+
+TEST(TNodePool, reuses_freed_nodes)
+{
+    TNodePool<TListNode<int>> pool;
+    void* a = pool.allocate();
+    pool.deallocate(a);
+
+    EXPECT_EQ(a, pool.allocate());
+}
+
+TEST(TNodePool, reserve_allocates_single_slab)
+{
+    TNodePool<TListNode<int>> pool;
+    pool.reserve(1000);
+
+    EXPECT_EQ(1000u, pool.capacity());
+    for (int i = 0; i < 1000; i++)
+        pool.allocate();
+    EXPECT_EQ(1000u, pool.capacity());
+}
+
+TEST(TNodePool, reserve_throws_when_slab_size_overflows)
+{
+    TNodePool<TListNode<int>> pool;
+
+    ASSERT_THROW(pool.reserve(numeric_limits<size_t>::max() / 8), length_error);
+    ASSERT_THROW(TList<int>(numeric_limits<size_t>::max() / 24 + 1), length_error);
+    EXPECT_EQ(0u, pool.capacity());
+}
+
+TEST(TList, can_recycle_nodes_in_erase_insert_cycle)
+{
+    TList<int> l;
+    for (int i = 0; i < 100; i++)
+        l.push_back(i);
+    for (int k = 0; k < 1000; k++)
+    {
+        l.pop_front();
+        l.push_back(k);
+    }
+
+    EXPECT_EQ(100u, l.size());
+    EXPECT_EQ(999, l.back());
+}
+
+TEST(TList, can_splice_range_from_other_list)
+{
+    TList<int> a = {1, 5};
+    TList<int> b = {2, 3, 4, 6};
+    a.splice(a.find(5), b, b.begin(), b.find(6));
+
+    EXPECT_EQ(vector<int>({1, 2, 3, 4, 5}), toVector(a));
+    EXPECT_EQ(vector<int>({6}), toVector(b));
+    EXPECT_EQ(1u, b.size());
+}
+
+TEST(TList, can_splice_within_same_list)
+{
+    TList<int> l = {1, 2, 3, 4};
+    l.splice(l.begin(), l, l.find(3), l.end());
+
+    EXPECT_EQ(vector<int>({3, 4, 1, 2}), toVector(l));
+    EXPECT_EQ(4u, l.size());
+}
+
+TEST(TList, splice_of_element_before_itself_is_noop)
+{
+    TList<int> l = {1, 2, 3};
+    l.splice(l.find(2), l, l.find(2));
+    l.splice(l.find(3), l, l.find(2));
+
+    EXPECT_EQ(vector<int>({1, 2, 3}), toVector(l));
+    EXPECT_EQ(3u, l.size());
+}
+
+TEST(TList, spliced_nodes_outlive_source_list)
+{
+    TList<string> a;
+    {
+        TList<string> b = {"x", "y", "z"};
+        a.splice(a.end(), b, b.find("y"));
+        b.push_back("w");
+    }
+    a.push_back("v");
+
+    EXPECT_EQ(vector<string>({"y", "v"}), toVector(a));
+}
+
+TEST(TList, can_concat_lists)
+{
+    TList<int> a = {1, 2};
+    TList<int> b = {3, 4};
+    a.concat(std::move(b));
+    a.concat(TList<int>());
+
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(vector<int>({1, 2, 3, 4}), toVector(a));
+}
+
+TEST(TList, can_split_list)
+{
+    TList<int> l = {1, 2, 3, 4, 5};
+    TList<int> tail = l.split_at(l.find(2));
+
+    EXPECT_EQ(vector<int>({1}), toVector(l));
+    EXPECT_EQ(vector<int>({2, 3, 4, 5}), toVector(tail));
+    EXPECT_EQ(4u, tail.size());
+    EXPECT_TRUE(l.split_at(l.end()).empty());
+    EXPECT_EQ(1u, l.split_at(l.begin()).size());
+    EXPECT_TRUE(l.empty());
+}
+
+TEST(TList, split_part_survives_original_list)
+{
+    TList<string> tail;
+    {
+        TList<string> l = {"a", "b", "c", "d"};
+        tail = l.split_at(l.find("c"));
+        l.push_back("e");
+    }
+    tail.push_front("b");
+
+    EXPECT_EQ(vector<string>({"b", "c", "d"}), toVector(tail));
+}
+
+TEST(TList, can_assemble_list_from_partial_results)
+{
+    TList<int> parts[4];
+    for (int p = 0; p < 4; p++)
+        for (int i = 0; i < 100; i++)
+            parts[p].push_back(p * 100 + i);
+    TList<int> res;
+    for (int p = 0; p < 4; p++)
+        res.concat(std::move(parts[p]));
+    parts[0].push_back(-1);
+    res.erase(res.begin());
+
+    EXPECT_EQ(399u, res.size());
+    EXPECT_EQ(1, res.front());
+    EXPECT_EQ(399, res.back());
+}
+
+TEST(TList, can_sort_list)
+{
+    TList<int> l = {5, 3, 9, 1, 3, 7, 2};
+    l.sort();
+
+    EXPECT_EQ(vector<int>({1, 2, 3, 3, 5, 7, 9}), toVector(l));
+    EXPECT_EQ(vector<int>({9, 7, 5, 3, 3, 2, 1}), vector<int>(l.rbegin(), l.rend()));
+}
+
+TEST(TList, sort_is_stable)
+{
+    TList<pair<int, int>> l;
+    vector<pair<int, int>> v;
+    unsigned seed = 7;
+    for (int i = 0; i < 1000; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        l.push_back({int((seed >> 8) % 17), i});
+        v.push_back(l.back());
+    }
+    auto byKey = [](const pair<int, int>& a, const pair<int, int>& b) { return a.first < b.first; };
+    l.sort(byKey);
+    stable_sort(v.begin(), v.end(), byKey);
+
+    EXPECT_EQ(v, toVector(l));
+}
+
+TEST(TList, sort_keeps_iterators_valid)
+{
+    TList<int> l = {3, 1, 2};
+    auto it = l.find(3);
+    l.sort(greater<int>());
+
+    EXPECT_EQ(3, *it);
+    EXPECT_TRUE(it == l.begin());
+    EXPECT_EQ(3u, l.size());
+}
+
+TEST(TList, parallel_sort_matches_serial_sort)
+{
+    TList<pair<int, int>> l;
+    unsigned seed = 99;
+    for (int i = 0; i < 200000; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        l.push_back({int((seed >> 8) % 1000), i});
+    }
+    TList<pair<int, int>> s(l);
+    auto byKey = [](const pair<int, int>& a, const pair<int, int>& b) { return a.first < b.first; };
+    l.parallel_sort(byKey, 5);
+    s.sort(byKey);
+
+    EXPECT_EQ(s, l);
+    EXPECT_EQ(200000u, l.size());
+    EXPECT_EQ(toVector(s), toVector(l));
+}
+
+TEST(TList, parallel_sort_handles_small_lists)
+{
+    TList<int> l = {3, 2, 1};
+    l.parallel_sort();
+
+    EXPECT_EQ(vector<int>({1, 2, 3}), toVector(l));
+}
+
+TEST(TList, can_use_memory_resource)
+{
+    char buf[1 << 16];
+    pmr::monotonic_buffer_resource arena(buf, sizeof(buf), pmr::null_memory_resource());
+    TList<int> l(&arena);
+    for (int i = 0; i < 1000; i++)
+        l.push_back(i);
+
+    EXPECT_EQ(&arena, l.resource());
+    EXPECT_EQ(1000u, l.size());
+    EXPECT_EQ(999, l.back());
+}
+
+TEST(TList, copy_uses_default_resource_unless_given)
+{
+    char buf[1 << 12];
+    pmr::monotonic_buffer_resource arena(buf, sizeof(buf), pmr::null_memory_resource());
+    TList<int> l({1, 2, 3}, &arena);
+    TList<int> c(l);
+    TList<int> a(l, &arena);
+
+    EXPECT_EQ(pmr::get_default_resource(), c.resource());
+    EXPECT_EQ(&arena, a.resource());
+    EXPECT_EQ(l, c);
+    EXPECT_EQ(l, a);
+}
+
+TEST(TList, copy_assignment_keeps_target_resource)
+{
+    char buf[1 << 12];
+    pmr::monotonic_buffer_resource arena(buf, sizeof(buf), pmr::null_memory_resource());
+    TList<int> l(&arena);
+    l = TList<int>({1, 2, 3});
+    TList<int> src = {4, 5};
+    l = src;
+
+    EXPECT_EQ(&arena, l.resource());
+    EXPECT_EQ(vector<int>({4, 5}), toVector(l));
+}
+
+TEST(TList, can_splice_between_lists_on_different_resources)
+{
+    pmr::unsynchronized_pool_resource other;
+    TList<string> a = {"a"};
+    {
+        TList<string> b({"b", "c"}, &other);
+        a.splice(a.end(), b, b.begin());
+    }
+    a.push_back("d");
+
+    EXPECT_EQ(vector<string>({"a", "b", "d"}), toVector(a));
+}
+
+TEST(TList, can_construct_from_range)
+{
+    vector<int> v = {1, 2, 3, 4};
+    TList<int> l(v.begin(), v.end());
+    TList<int> fromList(l.begin(), l.end());
+
+    EXPECT_EQ(v, toVector(l));
+    EXPECT_EQ(l, fromList);
+}
+
+TEST(TList, range_construction_places_nodes_contiguously)
+{
+    vector<int> v(1000);
+    TList<int> l(v.begin(), v.end());
+
+    EXPECT_TRUE(isContiguous(l));
+}
+
+TEST(TList, can_insert_range)
+{
+    TList<int> l = {1, 5};
+    vector<int> v = {2, 3, 4};
+    auto it = l.insert(l.find(5), v.begin(), v.end());
+
+    EXPECT_EQ(2, *it);
+    EXPECT_EQ(vector<int>({1, 2, 3, 4, 5}), toVector(l));
+    it = l.insert(l.end(), v.begin(), v.begin());
+    EXPECT_TRUE(it == l.end());
+    l.insert(l.begin(), 2, 0);
+    EXPECT_EQ(vector<int>({0, 0, 1, 2, 3, 4, 5}), toVector(l));
+}
+
+TEST(TList, can_assign_range)
+{
+    TList<int> l = {1, 2, 3};
+    vector<int> longer = {4, 5, 6, 7, 8};
+    l.assign(longer.begin(), longer.end());
+
+    EXPECT_EQ(longer, toVector(l));
+    l.assign({9});
+    EXPECT_EQ(vector<int>({9}), toVector(l));
+    l.assign(3, 1);
+    EXPECT_EQ(vector<int>({1, 1, 1}), toVector(l));
+}
+
+// Считает байты, выданные и ещё не возвращённые
+class TCountingResource : public pmr::memory_resource
+{
+    void* do_allocate(size_t bytes, size_t align) override
+    {
+        used += bytes;
+        return pmr::new_delete_resource()->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override
+    {
+        used -= bytes;
+        pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+    size_t used = 0;
+};
+
+TEST(TList, compact_restores_contiguous_layout)
+{
+    TList<string> l;
+    for (int i = 0; i < 500; i++)
+        l.push_back(to_string(i));
+    unsigned seed = 1;
+    for (int k = 0; k < 2000; k++)
+    {
+        seed = seed * 1103515245 + 12345;
+        auto it = l.begin();
+        advance(it, (seed >> 8) % l.size());
+        l.erase(it);
+        l.push_front(to_string(k));
+    }
+    vector<string> before = toVector(l);
+    l.compact();
+
+    EXPECT_EQ(before, toVector(l));
+    EXPECT_TRUE(isContiguous(l));
+    EXPECT_EQ(vector<string>(before.rbegin(), before.rend()), vector<string>(l.rbegin(), l.rend()));
+}
+
+TEST(TList, compact_releases_old_memory)
+{
+    TCountingResource counting;
+    TList<int> l(&counting);
+    for (int i = 0; i < 10000; i++)
+        l.push_back(i);
+    l.erase(++l.begin(), --l.end());
+    size_t before = counting.used;
+    l.compact();
+
+    EXPECT_LT(counting.used, before / 10);
+    EXPECT_EQ(vector<int>({0, 9999}), toVector(l));
+    l.push_back(1);
+    EXPECT_EQ(3u, l.size());
+}
+
+TEST(TList, dropped_split_part_returns_nodes_to_shared_pool)
+{
+    TCountingResource counting;
+    TList<int> l(&counting);
+    size_t afterFirst = 0;
+    for (int k = 0; k < 1000; k++)
+    {
+        for (int i = 0; i < 100; i++)
+            l.push_back(i);
+        l.split_at(l.begin());
+        if (k == 0)
+            afterFirst = counting.used;
+    }
+
+    EXPECT_TRUE(l.empty());
+    EXPECT_LE(counting.used, 2 * afterFirst);
+}
+
+TEST(TList, compact_keeps_nodes_shared_with_split_part)
+{
+    TList<string> l = {"a", "b", "c", "d"};
+    TList<string> tail = l.split_at(l.find("c"));
+    l.compact();
+    tail.push_back("e");
+
+    EXPECT_EQ(vector<string>({"a", "b"}), toVector(l));
+    EXPECT_EQ(vector<string>({"c", "d", "e"}), toVector(tail));
+}
+
+TEST(TUnrolledList, node_capacity_depends_on_element_size)
+{
+    EXPECT_GT(TUnrolledList<char>::NodeCapacity, TUnrolledList<int>::NodeCapacity);
+    EXPECT_GE(TUnrolledList<int>::NodeCapacity, 16u);
+}
+
+TEST(TUnrolledList, can_push_and_iterate)
+{
+    TUnrolledList<int, 4> l;
+    for (int i = 0; i < 10; i++)
+        l.push_back(i);
+    l.push_front(-1);
+
+    EXPECT_EQ(11u, l.size());
+    EXPECT_EQ(-1, l.front());
+    EXPECT_EQ(9, l.back());
+    EXPECT_EQ(vector<int>({9, 8, 7, 6, 5, 4, 3, 2, 1, 0, -1}), vector<int>(l.rbegin(), l.rend()));
+}
+
+TEST(TUnrolledList, can_insert_into_full_node)
+{
+    TUnrolledList<int, 4> l = {1, 2, 4, 5};
+    auto it = l.insert(l.find(4), 3);
+
+    EXPECT_EQ(3, *it);
+    EXPECT_EQ(vector<int>({1, 2, 3, 4, 5}), vector<int>(l.begin(), l.end()));
+}
+
+TEST(TUnrolledList, behaves_like_list_under_random_edits)
+{
+    TUnrolledList<int, 4> u;
+    TList<int> l;
+    unsigned seed = 12345;
+    for (int k = 0; k < 2000; k++)
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t pos = l.empty() ? 0 : (seed >> 8) % (l.size() + 1);
+        auto ui = u.begin();
+        auto li = l.begin();
+        for (size_t i = 0; i < pos; i++, ++ui, ++li)
+            ;
+        if ((seed >> 4) % 3 == 0 && li != l.end())
+        {
+            ui = u.erase(ui);
+            li = l.erase(li);
+        }
+        else
+        {
+            ui = u.insert(ui, k);
+            li = l.insert(li, k);
+        }
+        ASSERT_EQ(li == l.end(), ui == u.end());
+        if (li != l.end())
+        {
+            ASSERT_EQ(*li, *ui);
+        }
+    }
+
+    EXPECT_EQ(l.size(), u.size());
+    EXPECT_EQ(toVector(l), vector<int>(u.begin(), u.end()));
+}
+
+TEST(TUnrolledList, can_erase_range)
+{
+    TUnrolledList<string, 4> l;
+    for (int i = 0; i < 12; i++)
+        l.push_back(to_string(i));
+    auto first = l.find("2");
+    auto last = l.find("10");
+    auto it = l.erase(first, last);
+
+    EXPECT_EQ("10", *it);
+    EXPECT_EQ(vector<string>({"0", "1", "10", "11"}), vector<string>(l.begin(), l.end()));
+}
+
+TEST(TUnrolledList, copied_list_is_equal)
+{
+    TUnrolledList<string> l = {"a", "b", "c"};
+    TUnrolledList<string> c = l;
+
+    EXPECT_EQ(l, c);
+    c.pop_back();
+    EXPECT_NE(l, c);
+}
@@ -0,0 +1,344 @@
+#include <gtest.h>
+#include "TListIO.h"
+#include "TTestUtils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct TPoint
+{
+    int x;
+    double y;
+
+    bool operator==(const TPoint& p) const { return x == p.x && y == p.y; }
+};
+
+TEST(TListIO, can_save_and_load_binary)
+{
+    TList<int> l;
+    for (int i = 0; i < 100000; i++)
+        l.push_back(i * 7 - 3);
+    stringstream ss;
+    save_binary(ss, l);
+
+    TList<int> r = {1, 2, 3};
+    load_binary(ss, r);
+
+    EXPECT_EQ(toVector(l), toVector(r));
+}
+
+TEST(TListIO, binary_size_is_header_plus_payload)
+{
+    TList<int> l = {1, 2, 3, 4, 5};
+    stringstream ss;
+    save_binary(ss, l);
+
+    EXPECT_EQ(sizeof(TListFileHeader) + 5 * sizeof(int), ss.str().size());
+}
+
+TEST(TListIO, can_save_and_load_empty_list)
+{
+    TList<int> l;
+    stringstream ss;
+    save_binary(ss, l);
+
+    TList<int> r = {1, 2};
+    load_binary(ss, r);
+
+    EXPECT_TRUE(r.empty());
+}
+
+TEST(TListIO, can_save_and_load_structs)
+{
+    TList<TPoint> l = {{1, 0.5}, {2, -1.25}, {3, 1e10}};
+    stringstream ss;
+    save_binary(ss, l);
+
+    TList<TPoint> r;
+    load_binary(ss, r);
+
+    EXPECT_EQ(toVector(l), toVector(r));
+}
+
+TEST(TListIO, can_save_and_load_file)
+{
+    string path = "tlist_io_test.bin";
+    TList<long long> l = {5, 4, 3, 2, 1};
+    save_binary(path, l);
+
+    TList<long long> r;
+    load_binary(path, r);
+    remove(path.c_str());
+
+    EXPECT_EQ(toVector(l), toVector(r));
+}
+
+TEST(TListIO, load_throws_on_element_size_mismatch)
+{
+    TList<int> l = {1, 2, 3};
+    stringstream ss;
+    save_binary(ss, l);
+
+    TList<double> r;
+
+    ASSERT_ANY_THROW(load_binary(ss, r));
+}
+
+TEST(TListIO, load_throws_on_bad_magic)
+{
+    stringstream ss(string(sizeof(TListFileHeader), 'x'));
+    TList<int> r;
+
+    ASSERT_ANY_THROW(load_binary(ss, r));
+}
+
+TEST(TListIO, load_of_truncated_data_throws_and_keeps_list)
+{
+    TList<int> l = {1, 2, 3, 4};
+    stringstream out;
+    save_binary(out, l);
+    string data = out.str();
+    stringstream in(data.substr(0, data.size() - 2));
+
+    TList<int> r = {7, 8};
+    ASSERT_ANY_THROW(load_binary(in, r));
+    EXPECT_EQ(vector<int>({7, 8}), toVector(r));
+}
+
+// Поток без позиционирования, как канал или сокет
+struct TPipeBuf : streambuf
+{
+    string data;
+
+    explicit TPipeBuf(string s) : data(std::move(s))
+    {
+        setg(&data[0], &data[0], &data[0] + data.size());
+    }
+};
+
+TEST(TListIO, can_load_from_unseekable_stream)
+{
+    TList<int> l = {1, 2, 3};
+    stringstream ss;
+    save_binary(ss, l);
+    TPipeBuf pipe(ss.str());
+    istream in(&pipe);
+
+    TList<int> r;
+    load_binary(in, r);
+    EXPECT_EQ(toVector(l), toVector(r));
+}
+
+TEST(TListIO, huge_count_from_unseekable_stream_is_not_reserved)
+{
+    TList<int> l = {1, 2};
+    stringstream ss;
+    save_binary(ss, l);
+    string data = ss.str();
+    TListFileHeader h;
+    memcpy(&h, data.data(), sizeof(h));
+    h.count = (~uint64_t(0) - 16) / 24;
+    memcpy(&data[0], &h, sizeof(h));
+    TPipeBuf pipe(data);
+    istream in(&pipe);
+
+    TList<int> r = {7};
+    ASSERT_THROW(load_binary(in, r), runtime_error);
+    EXPECT_EQ(vector<int>({7}), toVector(r));
+}
+
+TEST(TListIO, load_throws_on_missing_file)
+{
+    TList<int> r;
+
+    ASSERT_ANY_THROW(load_binary(string("/nonexistent/dir/tlist.bin"), r));
+}
+
+TEST(TListIO, can_write_numbers_as_text)
+{
+    TList<int> l = {1, -20, 300};
+    stringstream ss;
+    ss << l;
+
+    EXPECT_EQ("1 -20 300", ss.str());
+}
+
+TEST(TListIO, can_read_numbers_from_text)
+{
+    stringstream ss("  4\n-5\t6  \r\n7");
+    TList<int> l = {1};
+    ss >> l;
+
+    EXPECT_EQ(vector<int>({4, -5, 6, 7}), toVector(l));
+    EXPECT_TRUE(ss.eof());
+    EXPECT_FALSE(ss.fail());
+}
+
+TEST(TListIO, text_round_trip_is_exact_for_doubles)
+{
+    TList<double> l = {0.1, -1e-300, 3.141592653589793, 1e22, 0};
+    stringstream ss;
+    ss << l;
+    TList<double> r;
+    ss >> r;
+
+    EXPECT_EQ(toVector(l), toVector(r));
+}
+
+TEST(TListIO, text_round_trip_of_large_list)
+{
+    TList<long long> l;
+    for (long long i = 0; i < 200000; i++)
+        l.push_back(i * 1000003 - 7);
+    stringstream ss;
+    ss << l;
+    TList<long long> r;
+    ss >> r;
+
+    EXPECT_EQ(toVector(l), toVector(r));
+}
+
+TEST(TListIO, read_of_bad_token_sets_failbit_and_keeps_list)
+{
+    stringstream ss("1 2 x3 4");
+    TList<int> l = {9};
+    ss >> l;
+
+    EXPECT_TRUE(ss.fail());
+    EXPECT_EQ(vector<int>({9}), toVector(l));
+}
+
+TEST(TListIO, read_from_failed_stream_keeps_list)
+{
+    stringstream ss("1 2");
+    ss.setstate(ios::failbit);
+    TList<int> l = {9};
+    ss >> l;
+
+    EXPECT_EQ(vector<int>({9}), toVector(l));
+    ss.clear();
+    ss >> l;
+    EXPECT_EQ(vector<int>({1, 2}), toVector(l));
+}
+
+TEST(TListIO, read_of_empty_stream_gives_empty_list)
+{
+    stringstream ss("");
+    TList<int> l = {9};
+    ss >> l;
+
+    EXPECT_TRUE(l.empty());
+    EXPECT_FALSE(ss.fail());
+}
+
+TEST(TListIO, read_of_out_of_range_number_sets_failbit)
+{
+    stringstream ss("1 300");
+    TList<unsigned char> l;
+    ss >> l;
+
+    EXPECT_TRUE(ss.fail());
+}
+
+TEST(TListIO, token_reader_handles_words_across_chunks)
+{
+    stringstream ss("12345678 ab  c 0123456789abcdef");
+    TTokenReader r(ss, 4);
+    vector<string> words;
+    for (string_view w = r.next(); !w.empty(); w = r.next())
+        words.push_back(string(w));
+
+    vector<string> expected = {"12345678", "ab", "c", "0123456789abcdef"};
+    EXPECT_EQ(expected, words);
+}
+
+TEST(TListIO, append_text_appends_to_existing_list)
+{
+    stringstream ss("3 4 5");
+    TList<int> l = {1, 2};
+
+    EXPECT_EQ(3u, append_text(ss, l));
+    EXPECT_EQ(vector<int>({1, 2, 3, 4, 5}), toVector(l));
+}
+
+TEST(TListIO, append_text_reports_progress_per_chunk)
+{
+    TList<int> src;
+    for (int i = 0; i < 1000; i++)
+        src.push_back(i);
+    stringstream ss;
+    ss << src;
+    size_t size = ss.str().size();
+
+    TList<int> l;
+    vector<uint64_t> done;
+    uint64_t total = 0;
+    append_text(ss, l, [&](uint64_t d, uint64_t t) { done.push_back(d); total = t; }, 256);
+
+    EXPECT_EQ(toVector(src), toVector(l));
+    EXPECT_EQ(size, total);
+    ASSERT_EQ((size + 255) / 256, done.size());
+    EXPECT_EQ(size, done.back());
+    EXPECT_TRUE(is_sorted(done.begin(), done.end()));
+}
+
+TEST(TListIO, append_text_with_zero_chunk_reads_everything)
+{
+    stringstream ss("10 200 3000");
+    TList<int> l;
+
+    EXPECT_EQ(3u, append_text(ss, l, TLoadProgress(), 0));
+    EXPECT_EQ(vector<int>({10, 200, 3000}), toVector(l));
+}
+
+TEST(TListIO, append_text_throws_on_bad_token_and_keeps_parsed_prefix)
+{
+    stringstream ss("1 2 oops 3");
+    TList<int> l;
+
+    ASSERT_ANY_THROW(append_text(ss, l));
+    EXPECT_EQ(vector<int>({1, 2}), toVector(l));
+}
+
+TEST(TListIO, append_binary_appends_and_reports_progress)
+{
+    TList<int> src;
+    for (int i = 0; i < 1000; i++)
+        src.push_back(i);
+    stringstream ss;
+    save_binary(ss, src);
+    size_t size = ss.str().size();
+
+    TList<int> l = {-1};
+    vector<uint64_t> done;
+    size_t n = append_binary(ss, l, [&](uint64_t d, uint64_t) { done.push_back(d); }, 400);
+
+    EXPECT_EQ(1000u, n);
+    EXPECT_EQ(1001u, l.size());
+    EXPECT_EQ(-1, l.front());
+    EXPECT_EQ(999, l.back());
+    EXPECT_EQ(10u, done.size());
+    EXPECT_EQ(size, done.back());
+}
+
+TEST(TListIO, can_append_from_files)
+{
+    string path = "tlist_append_test.txt";
+    {
+        ofstream os(path);
+        os << "10 20\n30\n";
+    }
+    TList<long> l;
+    append_text(path, l);
+    remove(path.c_str());
+
+    EXPECT_EQ(vector<long>({10, 20, 30}), toVector(l));
+    ASSERT_ANY_THROW(append_binary(path, l));
+}
@@ -0,0 +1,230 @@
+#include <gtest.h>
+#include "TMappedList.h"
+#include "TTestUtils.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Имя файла, удаляемого до и после теста
+struct TTempFile
+{
+    string path;
+
+    explicit TTempFile(const string& name) : path(name)
+    {
+        remove(path.c_str());
+    }
+
+    ~TTempFile()
+    {
+        remove(path.c_str());
+    }
+};
+
+TEST(TMappedList, new_file_gives_empty_list)
+{
+    TTempFile f("tmapped_empty.bin");
+    TMappedList<int> l(f.path);
+
+    EXPECT_TRUE(l.empty());
+    EXPECT_EQ(0u, l.size());
+    EXPECT_TRUE(l.begin() == l.end());
+}
+
+TEST(TMappedList, can_push_and_pop)
+{
+    TTempFile f("tmapped_push.bin");
+    TMappedList<int> l(f.path);
+    l.push_back(2);
+    l.push_back(3);
+    l.push_front(1);
+
+    EXPECT_EQ(vector<int>({1, 2, 3}), toVector(l));
+    l.pop_front();
+    l.pop_back();
+    EXPECT_EQ(vector<int>({2}), toVector(l));
+    EXPECT_EQ(2, l.front());
+    EXPECT_EQ(2, l.back());
+}
+
+TEST(TMappedList, can_insert_and_erase_in_middle)
+{
+    TTempFile f("tmapped_insert.bin");
+    TMappedList<int> l(f.path);
+    for (int v : {1, 2, 4})
+        l.push_back(v);
+    l.insert(l.find(4), 3);
+    l.erase(l.find(2));
+
+    EXPECT_EQ(vector<int>({1, 3, 4}), toVector(l));
+    EXPECT_EQ(3u, l.size());
+}
+
+TEST(TMappedList, survives_reopen)
+{
+    TTempFile f("tmapped_reopen.bin");
+    {
+        TMappedList<long long> l(f.path);
+        for (long long i = 0; i < 100000; i++)
+            l.push_back(i * i);
+        l.erase(l.begin());
+    }
+    TMappedList<long long> l(f.path);
+
+    ASSERT_EQ(99999u, l.size());
+    EXPECT_EQ(1, l.front());
+    EXPECT_EQ(99999ll * 99999ll, l.back());
+}
+
+TEST(TMappedList, iterators_survive_growth)
+{
+    TTempFile f("tmapped_grow.bin");
+    TMappedList<int> l(f.path);
+    l.push_back(-1);
+    TMappedList<int>::iterator it = l.begin();
+    for (int i = 0; i < 50000; i++)
+        l.push_back(i);
+
+    EXPECT_EQ(-1, *it);
+    EXPECT_EQ(0, *++it);
+}
+
+TEST(TMappedList, can_push_own_element_while_growing)
+{
+    TTempFile f("tmapped_self.bin");
+    TMappedList<int> l(f.path);
+    l.push_back(7);
+    for (int i = 0; i < 50000; i++)
+        l.push_back(l.front());
+
+    EXPECT_EQ(50001u, l.size());
+    EXPECT_EQ(7, l.back());
+}
+
+struct TPage
+{
+    char data[16384];
+};
+
+TEST(TMappedList, can_store_elements_larger_than_file)
+{
+    TTempFile f("tmapped_big.bin");
+    TMappedList<TPage> l(f.path);
+    TPage p = {};
+    for (int i = 0; i < 5; i++)
+    {
+        p.data[sizeof(p.data) - 1] = char(i);
+        l.push_back(p);
+    }
+
+    EXPECT_EQ(5u, l.size());
+    EXPECT_EQ(0, l.front().data[sizeof(p.data) - 1]);
+    EXPECT_EQ(4, l.back().data[sizeof(p.data) - 1]);
+}
+
+TEST(TMappedList, erased_nodes_are_reused)
+{
+    TTempFile f("tmapped_reuse.bin");
+    TMappedList<int> l(f.path);
+    for (int i = 0; i < 100; i++)
+        l.push_back(i);
+    size_t used = l.bytes_used();
+    for (int i = 0; i < 50; i++)
+        l.pop_front();
+    for (int i = 0; i < 50; i++)
+        l.push_back(i);
+
+    EXPECT_EQ(used, l.bytes_used());
+    EXPECT_EQ(100u, l.size());
+}
+
+TEST(TMappedList, can_clear)
+{
+    TTempFile f("tmapped_clear.bin");
+    TMappedList<int> l(f.path);
+    for (int i = 0; i < 10; i++)
+        l.push_back(i);
+    l.clear();
+    l.push_back(7);
+
+    EXPECT_EQ(vector<int>({7}), toVector(l));
+}
+
+TEST(TMappedList, can_iterate_backwards)
+{
+    TTempFile f("tmapped_back.bin");
+    TMappedList<int> l(f.path);
+    for (int v : {1, 2, 3})
+        l.push_back(v);
+    vector<int> r;
+    for (auto it = l.end(); it != l.begin();)
+        r.push_back(*--it);
+
+    EXPECT_EQ(vector<int>({3, 2, 1}), r);
+}
+
+TEST(TMappedList, throws_on_element_type_mismatch)
+{
+    TTempFile f("tmapped_mismatch.bin");
+    {
+        TMappedList<int> l(f.path);
+        l.push_back(1);
+    }
+
+    ASSERT_ANY_THROW(TMappedList<double> l(f.path));
+}
+
+TEST(TMappedList, throws_on_foreign_file)
+{
+    TTempFile f("tmapped_foreign.bin");
+    FILE* fp = fopen(f.path.c_str(), "wb");
+    fputs("not a list", fp);
+    fclose(fp);
+
+    ASSERT_ANY_THROW(TMappedList<int> l(f.path));
+}
+
+// Записывает v поверх поля заголовка со смещением off
+static void patchHeader(const string& path, size_t off, uint64_t v)
+{
+    FILE* fp = fopen(path.c_str(), "r+b");
+    fseek(fp, long(off), SEEK_SET);
+    fwrite(&v, sizeof(v), 1, fp);
+    fclose(fp);
+}
+
+TEST(TMappedList, throws_on_corrupted_links)
+{
+    size_t fields[] = {offsetof(TMappedHeader, used), offsetof(TMappedHeader, freeList),
+                       offsetof(TMappedHeader, head) + offsetof(TMappedLink, next),
+                       offsetof(TMappedHeader, head) + offsetof(TMappedLink, prev)};
+    for (size_t off : fields)
+    {
+        for (uint64_t bad : {uint64_t(3), uint64_t(1) << 20})
+        {
+            TTempFile f("tmapped_corrupt.bin");
+            {
+                TMappedList<int> l(f.path);
+                l.push_back(1);
+                l.push_back(2);
+                l.pop_back();
+            }
+            patchHeader(f.path, off, bad);
+
+            ASSERT_THROW(TMappedList<int> l(f.path), runtime_error);
+        }
+    }
+}
+
+TEST(TMappedList, erase_end_throws)
+{
+    TTempFile f("tmapped_erase_end.bin");
+    TMappedList<int> l(f.path);
+
+    ASSERT_ANY_THROW(l.erase(l.end()));
+    ASSERT_ANY_THROW(l.pop_back());
+}
@@ -0,0 +1,41 @@
+#include <gtest.h>
+#include "TParallel.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+TEST(TParallel, runs_every_index_once)
+{
+    vector<atomic<int>> hits(8);
+    runParallel(hits.size(), [&hits](size_t i) { hits[i]++; });
+
+    for (atomic<int>& h : hits)
+        EXPECT_EQ(1, h.load());
+}
+
+TEST(TParallel, zero_and_one_calls)
+{
+    int calls = 0;
+    runParallel(0, [&calls](size_t) { calls++; });
+    EXPECT_EQ(0, calls);
+    runParallel(1, [&calls](size_t i) { calls += int(i) + 1; });
+    EXPECT_EQ(1, calls);
+}
+
+TEST(TParallel, rethrows_after_all_calls_finish)
+{
+    for (size_t bad : {size_t(0), size_t(3)})
+    {
+        atomic<int> done(0);
+        ASSERT_THROW(runParallel(4, [&done, bad](size_t i) {
+                         if (i == bad)
+                             throw runtime_error("bad index");
+                         done++;
+                     }),
+                     runtime_error);
+        EXPECT_EQ(3, done.load());
+    }
+}
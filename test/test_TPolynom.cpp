@@ -0,0 +1,318 @@
+#include <gtest.h>
+#include "TPolynom.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+TEST(TPolynom, default_polynom_is_zero)
+{
+    TPolynom p;
+
+    EXPECT_TRUE(p.empty());
+    EXPECT_EQ(0, p(1, 2, 3));
+}
+
+TEST(TPolynom, terms_are_sorted_and_combined)
+{
+    TPolynom p = {{1, 0, 0, 1}, {2, 1, 0, 0}, {3, 0, 0, 1}, {4, 0, 2, 0}};
+
+    vector<TMonom> expected = {{2, 1, 0, 0}, {4, 0, 2, 0}, {4, 0, 0, 1}};
+    EXPECT_EQ(expected, vector<TMonom>(p.monoms().begin(), p.monoms().end()));
+    EXPECT_EQ(4, p.coef(0, 0, 1));
+    EXPECT_EQ(0, p.coef(5, 5, 5));
+}
+
+TEST(TPolynom, zero_terms_are_dropped)
+{
+    TPolynom p = {{1, 1, 0, 0}, {-1, 1, 0, 0}, {0, 0, 1, 0}};
+
+    EXPECT_TRUE(p.empty());
+}
+
+TEST(TPolynom, monom_exponents_can_be_read_back)
+{
+    TMonom m(1, 7, 0, 65535);
+
+    EXPECT_EQ(7u, m.exp(0));
+    EXPECT_EQ(0u, m.exp(1));
+    EXPECT_EQ(65535u, m.exp(2));
+    ASSERT_ANY_THROW(TMonom(1, 65536, 0, 0));
+}
+
+TEST(TPolynom, can_add)
+{
+    TPolynom p = {{1, 2, 0, 0}, {2, 0, 1, 0}};
+    TPolynom q = {{3, 2, 0, 0}, {5, 0, 0, 0}};
+
+    EXPECT_EQ(TPolynom({{4, 2, 0, 0}, {2, 0, 1, 0}, {5, 0, 0, 0}}), p + q);
+}
+
+TEST(TPolynom, can_subtract_to_zero)
+{
+    TPolynom p = {{1, 2, 0, 0}, {2, 0, 1, 0}};
+
+    EXPECT_TRUE((p - p).empty());
+}
+
+TEST(TPolynom, add_to_itself_doubles)
+{
+    TPolynom p = {{1, 2, 0, 0}, {2, 0, 1, 0}};
+    p += p;
+
+    EXPECT_EQ(TPolynom({{2, 2, 0, 0}, {4, 0, 1, 0}}), p);
+}
+
+TEST(TPolynom, can_multiply)
+{
+    // (x + y)(x - y) = x^2 - y^2
+    TPolynom p = {{1, 1, 0, 0}, {1, 0, 1, 0}};
+    TPolynom q = {{1, 1, 0, 0}, {-1, 0, 1, 0}};
+
+    EXPECT_EQ(TPolynom({{1, 2, 0, 0}, {-1, 0, 2, 0}}), p * q);
+}
+
+TEST(TPolynom, can_square_in_place)
+{
+    // (x + 1)^2 = x^2 + 2x + 1
+    TPolynom p = {{1, 1, 0, 0}, {1, 0, 0, 0}};
+    p *= p;
+
+    EXPECT_EQ(TPolynom({{1, 2, 0, 0}, {2, 1, 0, 0}, {1, 0, 0, 0}}), p);
+}
+
+TEST(TPolynom, multiply_throws_on_exponent_overflow)
+{
+    TPolynom p = {{1, 0, 40000, 0}};
+
+    ASSERT_ANY_THROW(p * p);
+}
+
+TEST(TPolynom, can_multiply_by_scalar)
+{
+    TPolynom p = {{1, 1, 0, 0}, {2, 0, 0, 0}};
+
+    EXPECT_EQ(TPolynom({{3, 1, 0, 0}, {6, 0, 0, 0}}), p * 3.0);
+    EXPECT_TRUE((p * 0.0).empty());
+    EXPECT_EQ(TPolynom({{-1, 1, 0, 0}, {-2, 0, 0, 0}}), -p);
+}
+
+TEST(TPolynom, can_evaluate)
+{
+    // 2x^2 y - 3z + 1
+    TPolynom p = {{2, 2, 1, 0}, {-3, 0, 0, 1}, {1, 0, 0, 0}};
+
+    EXPECT_DOUBLE_EQ(2 * 9 * 2 - 3 * 5 + 1, p(3, 2, 5));
+}
+
+TEST(TPolynom, product_evaluates_to_product_of_values)
+{
+    TPolynom p, q;
+    for (unsigned i = 0; i < 30; i++)
+    {
+        p += TPolynom({{double(i + 1), i % 4, i % 3, i % 5}});
+        q += TPolynom({{1.0 / (i + 1), i % 3, i % 5, i % 2}});
+    }
+
+    EXPECT_NEAR(p(0.5, -1.5, 1.25) * q(0.5, -1.5, 1.25), (p * q)(0.5, -1.5, 1.25), 1e-6);
+}
+
+// Многочлен с целыми коэффициентами: произведения считаются точно
+static TPolynom randomPolynom(size_t n, unsigned maxExp, unsigned seed)
+{
+    TList<TMonom> l;
+    for (size_t i = 0; i < n; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        unsigned r = seed >> 8;
+        l.push_back(TMonom(double(int(r % 19) - 9), r % (maxExp + 1), (r >> 7) % (maxExp + 1), (r >> 14) % (maxExp + 1)));
+    }
+    return TPolynom(std::move(l));
+}
+
+TEST(TPolynom, heap_and_hash_products_agree_on_sparse_operands)
+{
+    TPolynom p = randomPolynom(200, 100, 1), q = randomPolynom(300, 100, 2);
+
+    TPolynom h = TPolynom::multiply(p, q, TMulMethod::Heap);
+    EXPECT_EQ(h, TPolynom::multiply(p, q, TMulMethod::Hash));
+    EXPECT_EQ(h, p * q);
+}
+
+TEST(TPolynom, heap_and_hash_products_agree_on_dense_operands)
+{
+    TPolynom p = randomPolynom(200, 5, 3), q = randomPolynom(100, 5, 4);
+
+    TPolynom h = TPolynom::multiply(p, q, TMulMethod::Heap);
+    EXPECT_EQ(h, TPolynom::multiply(p, q, TMulMethod::Hash));
+    EXPECT_EQ(h, q * p);
+}
+
+TEST(TPolynom, heap_product_cancels_terms)
+{
+    // (x - y)(x^2 + xy + y^2) = x^3 - y^3
+    TPolynom p = {{1, 1, 0, 0}, {-1, 0, 1, 0}};
+    TPolynom q = {{1, 2, 0, 0}, {1, 1, 1, 0}, {1, 0, 2, 0}};
+
+    TPolynom expected = {{1, 3, 0, 0}, {-1, 0, 3, 0}};
+    EXPECT_EQ(expected, TPolynom::multiply(p, q, TMulMethod::Heap));
+    EXPECT_EQ(expected, TPolynom::multiply(p, q, TMulMethod::Hash));
+}
+
+TEST(TPolynom, product_with_zero_is_zero)
+{
+    TPolynom p = {{1, 1, 0, 0}};
+
+    EXPECT_TRUE((p * TPolynom()).empty());
+    EXPECT_TRUE((TPolynom() * p).empty());
+}
+
+TEST(TPolynom, move_add_merges_nodes)
+{
+    TPolynom p = {{1, 2, 0, 0}, {2, 1, 0, 0}, {3, 0, 0, 0}};
+    TPolynom q = {{5, 3, 0, 0}, {-2, 1, 0, 0}, {1, 0, 1, 0}, {4, 0, 0, 0}};
+    p += std::move(q);
+
+    EXPECT_EQ(TPolynom({{5, 3, 0, 0}, {1, 2, 0, 0}, {1, 0, 1, 0}, {7, 0, 0, 0}}), p);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(TPolynom, parallel_product_matches_sequential)
+{
+    TPolynom p = randomPolynom(600, 200, 5), q = randomPolynom(700, 200, 6);
+    TPolynom expected = TPolynom::multiply(p, q);
+
+    for (unsigned threads : {1u, 2u, 3u, 4u, 7u})
+        EXPECT_EQ(expected, TPolynom::parallel_multiply(p, q, threads));
+}
+
+TEST(TPolynom, parallel_product_matches_sequential_for_each_method)
+{
+    TPolynom p = randomPolynom(600, 12, 7), q = randomPolynom(700, 12, 8);
+    TPolynom expected = TPolynom::multiply(p, q, TMulMethod::Heap);
+
+    EXPECT_EQ(expected, TPolynom::parallel_multiply(p, q, 4, TMulMethod::Heap));
+    EXPECT_EQ(expected, TPolynom::parallel_multiply(p, q, 4, TMulMethod::Hash));
+}
+
+TEST(TPolynom, parallel_product_of_small_operands)
+{
+    TPolynom p = {{1, 1, 0, 0}, {1, 0, 1, 0}};
+
+    EXPECT_EQ(p * p, TPolynom::parallel_multiply(p, p, 8));
+    EXPECT_TRUE(TPolynom::parallel_multiply(p, TPolynom(), 8).empty());
+}
+
+TEST(TPolynom, batch_evaluation_matches_pointwise)
+{
+    TPolynom p = randomPolynom(500, 12, 9);
+    vector<double> x, y, z;
+    for (int i = 0; i < 203; i++)
+    {
+        x.push_back(0.9 + 0.001 * i);
+        y.push_back(-1.05 + 0.0007 * i);
+        z.push_back(0.5 - 0.002 * i);
+    }
+    vector<double> r = p.evaluate(x, y, z);
+
+    ASSERT_EQ(x.size(), r.size());
+    for (size_t i = 0; i < r.size(); i++)
+        EXPECT_NEAR(p(x[i], y[i], z[i]), r[i], 1e-9 * (1 + abs(r[i])));
+}
+
+TEST(TPolynom, batch_evaluation_handles_high_degrees)
+{
+    TPolynom p = {{1, 60000, 0, 0}, {2, 0, 3, 0}, {-1, 7, 0, 65535}};
+    vector<double> x = {1, -1, 0.5}, y = {2, 3, 4}, z = {1, -1, 1};
+    vector<double> r = p.evaluate(x, y, z);
+
+    for (size_t i = 0; i < r.size(); i++)
+        EXPECT_DOUBLE_EQ(p(x[i], y[i], z[i]), r[i]);
+}
+
+TEST(TPolynom, batch_evaluation_of_zero_polynom)
+{
+    TPolynom p;
+
+    EXPECT_EQ(vector<double>({0, 0}), p.evaluate({1, 2}, {3, 4}, {5, 6}));
+}
+
+TEST(TPolynom, batch_evaluation_throws_on_size_mismatch)
+{
+    TPolynom p = {{1, 1, 0, 0}};
+
+    ASSERT_ANY_THROW(p.evaluate({1, 2}, {3}, {5, 6}));
+}
+
+TEST(TPackedExps, can_pack_and_unpack)
+{
+    using TExps = TPackedExps<8, 7>;
+    uint64_t k = TExps::pack(1, 2, 3, 4, 5, 6, 7, 127);
+
+    for (unsigned v = 0; v < 7; v++)
+        EXPECT_EQ(v + 1, TExps::get(k, v));
+    EXPECT_EQ(127u, TExps::get(k, 7));
+    EXPECT_FALSE(TExps::overflowed(k));
+    ASSERT_ANY_THROW(TExps::pack(0, 0, 0, 0, 0, 0, 0, 128));
+}
+
+TEST(TPackedExps, product_is_fieldwise_sum)
+{
+    using TExps = TPackedExps<4, 15>;
+    uint64_t k = TExps::mul(TExps::pack(1, 2, 3, 4), TExps::pack(10, 20, 30, 32767 - 4));
+
+    EXPECT_FALSE(TExps::overflowed(k));
+    EXPECT_EQ(TExps::pack(11, 22, 33, 32767), k);
+}
+
+TEST(TPackedExps, guard_bits_detect_overflow_in_any_field)
+{
+    using TExps = TPackedExps<4, 15>;
+
+    for (unsigned v = 0; v < 4; v++)
+    {
+        unsigned e[4] = {1, 1, 1, 1};
+        e[v] = 20000;
+        uint64_t a = TExps::pack(e[0], e[1], e[2], e[3]);
+        uint64_t k = TExps::mul(a, a);
+        EXPECT_TRUE(TExps::overflowed(k));
+        // остальные поля не задеты переносом
+        for (unsigned w = 0; w < 4; w++)
+        {
+            if (w != v)
+            {
+                EXPECT_EQ(2u, TExps::get(k, w));
+            }
+        }
+    }
+}
+
+TEST(TPackedExps, key_order_is_lexicographic)
+{
+    using TExps = TPackedExps<3, 16>;
+    vector<uint64_t> keys = {TExps::pack(0, 0, 65535), TExps::pack(0, 1, 0), TExps::pack(0, 65535, 65535), TExps::pack(1, 0, 0)};
+
+    EXPECT_TRUE(is_sorted(keys.begin(), keys.end()));
+}
+
+TEST(TPackedExps, max_is_fieldwise)
+{
+    using TExps = TPackedExps<3, 16>;
+
+    EXPECT_EQ(TExps::pack(5, 7, 65535), TExps::max(TExps::pack(5, 2, 0), TExps::pack(1, 7, 65535)));
+    EXPECT_EQ(TExps::pack(3, 3, 3), TExps::max(TExps::pack(3, 3, 3), TExps::pack(3, 3, 3)));
+}
+
+TEST(TPackedExps, supports_fields_wider_than_32_bits)
+{
+    using TExps = TPackedExps<1, 40>;
+    uint64_t e = (uint64_t(1) << 40) - 1;
+    uint64_t k = TExps::pack(e);
+
+    EXPECT_EQ(e, TExps::MaxExp);
+    EXPECT_EQ(e, TExps::get(k, 0));
+    EXPECT_TRUE(TExps::overflowed(TExps::mul(k, TExps::pack(1))));
+    ASSERT_ANY_THROW(TExps::pack(e + 1));
+}
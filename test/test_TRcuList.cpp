@@ -0,0 +1,88 @@
+#include <gtest.h>
+#include "TRcuList.h"
+#include "TTestUtils.h"
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+TEST(TRcuList, can_push_and_read)
+{
+    TRcuList<int> l;
+    l.push_back(2);
+    l.push_back(3);
+    l.push_front(1);
+
+    EXPECT_EQ(vector<int>({1, 2, 3}), toVector(l.read()));
+    EXPECT_EQ(3u, l.size());
+    EXPECT_TRUE(l.contains(2));
+}
+
+TEST(TRcuList, can_erase_elements)
+{
+    TRcuList<int> l;
+    for (int i = 0; i < 6; i++)
+        l.push_back(i);
+
+    EXPECT_TRUE(l.erase(5));
+    EXPECT_FALSE(l.erase(7));
+    EXPECT_EQ(3u, l.erase_if([](int v) { return v % 2 == 0; }));
+    l.push_back(10);
+    EXPECT_EQ(vector<int>({1, 3, 10}), toVector(l.read()));
+    l.clear();
+    EXPECT_TRUE(l.empty());
+    l.push_back(4);
+    EXPECT_EQ(vector<int>({4}), toVector(l.read()));
+}
+
+TEST(TRcuList, can_replace_element)
+{
+    TRcuList<pair<int, int>> l;
+    l.push_back({1, 10});
+    l.push_back({2, 20});
+    bool replaced = l.replace_if([](const pair<int, int>& p) { return p.first == 2; }, {2, 25});
+    l.push_back({3, 30});
+
+    EXPECT_TRUE(replaced);
+    EXPECT_EQ(25, l.find_if([](const pair<int, int>& p) { return p.first == 2; })->second);
+    vector<pair<int, int>> expected = {{1, 10}, {2, 25}, {3, 30}};
+    EXPECT_EQ(expected, toVector(l.read()));
+    EXPECT_FALSE(l.find_if([](const pair<int, int>& p) { return p.first == 4; }).has_value());
+}
+
+TEST(TRcuList, readers_see_consistent_entries_during_updates)
+{
+    TRcuList<pair<int, int>> l;
+    for (int k = 0; k < 64; k++)
+        l.push_back({k, 2 * k});
+    atomic<bool> stop{false};
+    atomic<int> bad{0};
+    vector<thread> readers;
+    for (int t = 0; t < 4; t++)
+        readers.emplace_back([&] {
+            while (!stop)
+                l.for_each([&](const pair<int, int>& p) {
+                    if (p.second != 2 * p.first)
+                        bad++;
+                });
+        });
+    for (int i = 0; i < 3000; i++)
+    {
+        int k = i % 64;
+        l.replace_if([k](const pair<int, int>& p) { return p.first == k; }, {k, 2 * k});
+        if (i % 7 == 0)
+        {
+            l.erase_if([k](const pair<int, int>& p) { return p.first == k; });
+            l.push_back({k, 2 * k});
+        }
+    }
+    stop = true;
+    for (thread& r : readers)
+        r.join();
+
+    EXPECT_EQ(0, bad);
+    EXPECT_EQ(64u, l.size());
+}
@@ -0,0 +1,122 @@
+#include <gtest.h>
+#include "TSkipIndex.h"
+#include "TTestUtils.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+TEST(TSkipIndex, keeps_elements_sorted)
+{
+    TSkipIndex<int> s;
+    for (int v : {5, 1, 4, 2, 3})
+        s.insert(v);
+
+    EXPECT_EQ(vector<int>({1, 2, 3, 4, 5}), toVector(s));
+    EXPECT_EQ(5u, s.size());
+}
+
+TEST(TSkipIndex, can_find_keys)
+{
+    TSkipIndex<int> s;
+    for (int i = 0; i < 1000; i++)
+        s.insert(2 * i);
+
+    EXPECT_TRUE(s.contains(500));
+    EXPECT_FALSE(s.contains(501));
+    EXPECT_EQ(502, *s.lower_bound(501));
+    EXPECT_EQ(502, *s.upper_bound(500));
+    EXPECT_TRUE(s.lower_bound(5000) == s.end());
+    EXPECT_EQ(0, *s.find(0));
+    EXPECT_TRUE(s.find(-1) == s.end());
+}
+
+TEST(TSkipIndex, equal_keys_keep_insertion_order)
+{
+    auto byFirst = [](const pair<int, int>& a, const pair<int, int>& b) { return a.first < b.first; };
+    TSkipIndex<pair<int, int>, decltype(byFirst)> s(byFirst);
+    for (int i = 0; i < 100; i++)
+        s.insert({i % 3, i});
+
+    vector<pair<int, int>> v = toVector(s);
+    EXPECT_TRUE(is_sorted(v.begin(), v.end()));
+}
+
+TEST(TSkipIndex, matches_sorted_vector_under_random_edits)
+{
+    TSkipIndex<int> s;
+    vector<int> ref;
+    unsigned seed = 42;
+    for (int k = 0; k < 20000; k++)
+    {
+        seed = seed * 1103515245 + 12345;
+        int key = int((seed >> 8) % 500);
+        if ((seed >> 4) % 3 == 0)
+        {
+            auto it = find(ref.begin(), ref.end(), key);
+            ASSERT_EQ(it != ref.end(), s.erase(key));
+            if (it != ref.end())
+                ref.erase(it);
+        }
+        else
+        {
+            s.insert(key);
+            ref.insert(upper_bound(ref.begin(), ref.end(), key), key);
+        }
+    }
+
+    EXPECT_EQ(ref, toVector(s));
+    for (int key = 0; key < 500; key++)
+        ASSERT_EQ(binary_search(ref.begin(), ref.end(), key), s.contains(key));
+}
+
+TEST(TSkipIndex, can_index_existing_list)
+{
+    TList<string> l = {"pear", "apple", "fig"};
+    TSkipIndex<string> s(std::move(l));
+    s.insert("banana");
+
+    EXPECT_EQ(vector<string>({"apple", "banana", "fig", "pear"}), toVector(s));
+    TSkipIndex<string> m(std::move(s));
+    EXPECT_TRUE(m.contains("fig"));
+    TList<string> back = m.extract();
+    EXPECT_EQ(4u, back.size());
+    EXPECT_TRUE(m.empty());
+}
+
+TEST(TSkipIndex, copy_has_own_index)
+{
+    TSkipIndex<int> s;
+    for (int i = 0; i < 100; i++)
+        s.insert(i);
+    TSkipIndex<int> c(s);
+    s.clear();
+
+    EXPECT_TRUE(s.empty());
+    EXPECT_TRUE(c.contains(77));
+    EXPECT_EQ(100u, c.size());
+}
+
+TEST(TSkipIndex, move_assign_between_resources_rebuilds_index)
+{
+    TSkipIndex<int> d;
+    d.insert(-1);
+    {
+        pmr::unsynchronized_pool_resource pool;
+        TList<int> l(&pool);
+        for (int i = 0; i < 1000; i++)
+            l.push_back(i);
+        TSkipIndex<int> s(std::move(l));
+        d = std::move(s);
+        EXPECT_TRUE(s.empty());
+    }
+
+    EXPECT_EQ(1000u, d.size());
+    EXPECT_TRUE(d.contains(777));
+    EXPECT_FALSE(d.contains(-1));
+    EXPECT_EQ(500, *d.lower_bound(500));
+}